@@ -0,0 +1,95 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+Runs a command and reports its wall clock time, peak resident memory and
+hardware cache misses on stderr, as the last line after the output of the
+command itself:
+
+bench_run <milliseconds> ms <kilobytes> kB <misses> cache_misses
+
+The cache misses are counted with perf_event_open() on Linux, the count is
+'-' when the counters are not available (e.g. in a virtual machine or with
+a high kernel.perf_event_paranoid).
+
+Used by bench_solvers.sh, the exit code is the one of the command.*/
+
+// Needed for fork(), execvp() and clock_gettime()
+#define _POSIX_C_SOURCE 200809L
+// Needed for syscall()
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+#include "timer.h"
+
+/* Returns a disabled counter of the hardware cache misses of this process
+ * and its children, which starts counting when a child calls exec. Returns
+ * -1 if there is no such counter. */
+static int cache_miss_counter(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s command [arguments..]\n", argv[0]);
+        return 1;
+    }
+
+    int counter = cache_miss_counter();
+    double start = timer_ms();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    } else if (pid == 0) {
+        execvp(argv[1], argv + 1);
+        perror(argv[1]);
+        _exit(127);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0) {
+        perror("waitpid");
+        return 1;
+    }
+    double elapsed = timer_ms() - start;
+
+    /* ru_maxrss of the children is the peak of the largest child, the only
+    child here. */
+    struct rusage usage;
+    getrusage(RUSAGE_CHILDREN, &usage);
+    /* The counts of an inherited counter are added to the parent's counter
+    when the child exits. */
+    long long misses;
+    char count[32] = "-";
+    if (counter >= 0 && read(counter, &misses, sizeof(misses)) == sizeof(misses)) {
+        snprintf(count, sizeof(count), "%lld", misses);
+    }
+    fprintf(stderr, "bench_run %.3f ms %ld kB %s cache_misses\n", elapsed,
+            usage.ru_maxrss, count);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
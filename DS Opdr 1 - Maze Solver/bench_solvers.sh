@@ -0,0 +1,69 @@
+#! /usr/bin/env bash
+
+# Times the maze solvers on generated mazes over a ladder of sizes and
+# reports the path length, the visited (or expanded) cells, the solve time,
+# the maze cells solved per second, the total run time, the peak memory and
+# the cache misses of the whole run (if the hardware counters are available).
+# Build with 'make release' first for real timings.
+#
+# usage: bench_solvers.sh [-f] [-s styles] [-p solvers] [-l loop_percent]
+#                         [-r room_percent] [sizes..]
+#
+# A size is one number for a square maze or 'rows'x'cols'. A solver is the
+# name after maze_solver_, arguments follow after a colon, e.g. "bfs:-b" or
+# "pbfs:4".
+#
+# The solvers run with -q -r 1024, so printing the maze and a full size
+# out.ppm do not dominate the total time of large mazes. With -f they print
+# and write everything like a normal run.
+
+set -euo pipefail
+
+styles="open rooms backtracker prim kruskal"
+solvers="dfs bfs bfs:-b bitbfs astar jps pbfs junction dijkstra"
+generate_options=()
+output_options="-q -r 1024"
+while getopts "fs:p:l:r:" option; do
+    case $option in
+        f) output_options="" ;;
+        s) styles=$OPTARG ;;
+        p) solvers=$OPTARG ;;
+        l) generate_options+=(-l "$OPTARG") ;;
+        r) generate_options+=(-r "$OPTARG") ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+sizes=${*:-"501 1001 2001"}
+
+maze=$(mktemp)
+output=$(mktemp)
+stats=$(mktemp)
+trap 'rm -f "$maze" "$output" "$stats"' EXIT
+
+row="%-11s %-11s %-14s %9s %12s %10s %9s %10s %8s %12s\n"
+# shellcheck disable=SC2059
+printf "$row" style size solver length visited solve_ms Mcells/s total_ms peak_MB cache_misses
+for style in $styles; do
+    for size in $sizes; do
+        ./maze_generate "${generate_options[@]}" "$size" "$style" > "$maze"
+        rows=${size%x*}
+        cols=${size#*x}
+        for solver in $solvers; do
+            args=${solver#"${solver%%:*}"}
+            read -ra cmd <<< "./maze_solver_${solver%%:*} $output_options ${args#:}"
+            ./bench_run "${cmd[@]}" < "$maze" > "$output" 2> "$stats" || true
+
+            # The solvers print "<name> <verb> N cells in T ms" and
+            # bench_run "bench_run T ms M kB C cache_misses" on stderr.
+            length=$(head -n 1 "$output" | grep -o "length: [0-9]*" | cut -d " " -f 2 || true)
+            read -r _ _ cells _ _ ms _ < <(grep " cells in " "$stats" | tail -n 1) || true
+            read -r _ total _ kb _ misses _ < <(grep "^bench_run" "$stats") || true
+            rate=$(awk -v n="$((rows * cols))" -v ms="${ms:-0}" \
+                'BEGIN { if (ms > 0) printf "%.1f", n / ms / 1000; else print "-" }')
+            # shellcheck disable=SC2059
+            printf "$row" "$style" "$size" "${solver/:/ }" "${length:--}" "${cells:--}" \
+                "${ms:--}" "$rate" "${total:--}" "$(( ${kb:-0} / 1024 ))" "${misses:--}"
+        done
+    done
+done
@@ -0,0 +1,44 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bfs.h"
+#include "bitset.h"
+
+int bfs_search(struct maze *m, struct queue *queue, struct pred *pred) {
+    queue_clear(queue);
+
+    int r, c;
+    maze_destination(m, &r, &c);
+    int64_t dest_index = maze_index(m, r, c);
+    maze_start(m, &r, &c);
+    int64_t start_index = maze_index(m, r, c);
+
+    const uint64_t *walls = maze_walls(m);
+    const int64_t *steps = maze_steps(m);
+    uint64_t *visited = maze_visited(m);
+    if (queue_push(queue, start_index) != 0) {
+        return -2;
+    }
+    bitset_set(visited, (size_t)start_index);
+
+    while (queue_empty(queue) == 0) {
+        int64_t current_index = queue_pop(queue);
+        if (current_index == dest_index) {
+            return pred_backtrack(m, pred);
+        }
+
+        /* Only open cells are queued and the border is always a wall, so a
+         * neighbour is always inside the maze. */
+        for (int i = 0; i < N_MOVES; i++) {
+            size_t new_index = (size_t)maze_step(m, steps, current_index, i);
+            if (!bitset_get(walls, new_index) && !bitset_get(visited, new_index)) {
+                if (queue_push(queue, (int64_t)new_index) != 0) {
+                    return -2;
+                }
+                pred_set(pred, new_index, i);
+                bitset_set(visited, new_index);
+            }
+        }
+    }
+    return -1;
+}
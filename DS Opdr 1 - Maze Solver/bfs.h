@@ -0,0 +1,22 @@
+#ifndef _BFS_H_
+#define _BFS_H_
+
+#include "maze.h"
+#include "pred.h"
+#include "queue.h"
+
+/* Breadth-first search interface
+ * Finds a shortest path from the start to the destination of a maze. The
+ * queue and the predecessor store are owned by the caller, so a program
+ * that solves many mazes can reuse them instead of allocating them for
+ * every maze. */
+
+/* Search maze 'm' with 'queue' and 'pred', which must have room for at
+ * least maze_cells(m) cells. The queue is cleared first, 'pred' does not
+ * need to be cleared because the path only follows cells set during this
+ * search. The visited cells and the path are marked in 'm'.
+ * Return the length of the shortest path, -1 if there is no path, or -2 if
+ * the queue could not grow. */
+int bfs_search(struct maze *m, struct queue *queue, struct pred *pred);
+
+#endif
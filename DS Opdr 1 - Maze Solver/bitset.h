@@ -0,0 +1,29 @@
+#ifndef _BITSET_H_
+#define _BITSET_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Bitsets are arrays of 64-bit words, bit 'i' is bit (i % 64) of word
+ * (i / 64). These helpers are used for the maze walls and visited cells. */
+#define BITSET_WORD_BITS 64
+
+/* Returns the number of words needed to store 'nbits' bits. */
+static inline size_t bitset_words(size_t nbits) {
+    return (nbits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+static inline bool bitset_get(const uint64_t *set, size_t i) {
+    return (set[i / BITSET_WORD_BITS] >> (i % BITSET_WORD_BITS)) & 1;
+}
+
+static inline void bitset_set(uint64_t *set, size_t i) {
+    set[i / BITSET_WORD_BITS] |= (uint64_t)1 << (i % BITSET_WORD_BITS);
+}
+
+static inline void bitset_clear(uint64_t *set, size_t i) {
+    set[i / BITSET_WORD_BITS] &= ~((uint64_t)1 << (i % BITSET_WORD_BITS));
+}
+
+#endif
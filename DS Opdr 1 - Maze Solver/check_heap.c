@@ -0,0 +1,143 @@
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "heap.h"
+
+/* For older versions of the check library */
+#ifndef ck_assert_ptr_nonnull
+#define ck_assert_ptr_nonnull(X) _ck_assert_ptr(X, !=, NULL)
+#endif
+#ifndef ck_assert_ptr_null
+#define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
+#endif
+
+
+START_TEST(test_heap_init_cleanup) {
+    struct heap *h = heap_init(10);
+    ck_assert_ptr_nonnull(h);
+    ck_assert_int_eq(heap_empty(h), 1);
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_order) {
+    struct heap *h = heap_init(4);
+    int keys[] = { 5, 3, 9, 1, 7, 2, 8, 6, 4, 0 };
+    for (int i = 0; i < 10; i++) {
+        ck_assert_int_eq(heap_push(h, (uint64_t)keys[i], keys[i] * 10), 0);
+    }
+    ck_assert_int_eq(heap_size(h), 10);
+    ck_assert(heap_peek_key(h) == 0);
+
+    for (int i = 0; i < 10; i++) {
+        uint64_t key;
+        ck_assert_int_eq(heap_pop(h, &key), i * 10);
+        ck_assert(key == (uint64_t)i);
+    }
+    ck_assert_int_eq(heap_empty(h), 1);
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_duplicate_keys) {
+    struct heap *h = heap_init(1);
+    for (int i = 0; i < 100; i++) {
+        ck_assert_int_eq(heap_push(h, (uint64_t)(i % 3), i), 0);
+    }
+
+    uint64_t previous = 0;
+    for (int i = 0; i < 100; i++) {
+        uint64_t key;
+        int64_t value = heap_pop(h, &key);
+        ck_assert(key >= previous);
+        ck_assert(key == (uint64_t)(value % 3));
+        previous = key;
+    }
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_interleaved) {
+    struct heap *h = heap_init(0);
+    ck_assert_ptr_nonnull(h);
+    for (int i = 1000; i > 0; i--) {
+        ck_assert_int_eq(heap_push(h, (uint64_t)i, i), 0);
+        if (i % 2 == 0) {
+            ck_assert_int_eq(heap_pop(h, NULL), i);
+        }
+    }
+
+    for (int i = 1; i < 1000; i += 2) {
+        ck_assert_int_eq(heap_pop(h, NULL), i);
+    }
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_large_values) {
+    /* Cell indices of large mazes do not fit in an int. */
+    struct heap *h = heap_init(2);
+    int64_t big = (int64_t)1 << 40;
+    ck_assert_int_eq(heap_push(h, 2, big + 1), 0);
+    ck_assert_int_eq(heap_push(h, 1, big), 0);
+    ck_assert(heap_pop(h, NULL) == big);
+    ck_assert(heap_pop(h, NULL) == big + 1);
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_underflow) {
+    struct heap *h = heap_init(10);
+    ck_assert_int_eq(heap_pop(h, NULL), -1);
+    ck_assert(heap_peek_key(h) == UINT64_MAX);
+    heap_cleanup(h);
+}
+END_TEST
+
+START_TEST(test_heap_null_ptr) {
+    ck_assert_int_eq(heap_push(NULL, 1, 'x'), 1);
+    ck_assert_int_eq(heap_pop(NULL, NULL), -1);
+    ck_assert(heap_peek_key(NULL) == UINT64_MAX);
+    ck_assert_int_eq(heap_empty(NULL), -1);
+    ck_assert_int_eq(heap_size(NULL), 0);
+    heap_cleanup(NULL);
+}
+END_TEST
+
+Suite *heap_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+    TCase *tc_limits;
+    s = suite_create("heap");
+
+    tc_core = tcase_create("Core");
+    tcase_add_test(tc_core, test_heap_init_cleanup);
+    tcase_add_test(tc_core, test_heap_order);
+    tcase_add_test(tc_core, test_heap_duplicate_keys);
+    tcase_add_test(tc_core, test_heap_interleaved);
+
+    tc_limits = tcase_create("Limits");
+    tcase_add_test(tc_limits, test_heap_large_values);
+    tcase_add_test(tc_limits, test_heap_underflow);
+    tcase_add_test(tc_limits, test_heap_null_ptr);
+
+    suite_add_tcase(s, tc_core);
+    suite_add_tcase(s, tc_limits);
+
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = heap_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
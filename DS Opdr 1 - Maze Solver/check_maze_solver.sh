@@ -19,7 +19,8 @@ cleanup() {
 }
 
 function run_and_check_length() {
-    PROG="$1"
+    # The solver may be given with arguments, e.g. "./maze_solver_bfs -b".
+    read -ra CMD <<< "$1"
     input="$2"
     ref_output="$3"
     ret_val=${4:-0}
@@ -27,7 +28,7 @@ function run_and_check_length() {
     echo -n "Checking $(basename "$input"): "
 
     # First check if $PROG returns a 0 error code and bail
-    if ! "$PROG" < "$input" > /dev/null 2>&1;
+    if ! "${CMD[@]}" < "$input" > /dev/null 2>&1;
     then
         if [ "$ret_val" -eq 0 ]
         then
@@ -48,8 +49,9 @@ function run_and_check_length() {
     fi
 
     # NOTE: error message is not correct when no path is found with ret val 0
-    "$PROG" < "$input" | grep "found a path of length:" > tmp || true
-    if grep "found a path of length:" "$ref_output" | diff - tmp > /dev/null;
+    # Only compare the length, the solver name in front of it may differ.
+    "${CMD[@]}" < "$input" 2> /dev/null | grep -o "found a path of length:.*" > tmp || true
+    if grep -o "found a path of length:.*" "$ref_output" | diff - tmp > /dev/null;
     then
         echo "correct"
     else
@@ -65,13 +67,13 @@ function run_and_check_length() {
 }
 
 function run_and_check_path() {
-    PROG="$1"
+    read -ra CMD <<< "$1"
     input="$2"
     ref_output="$3"
     ret_val=${4:-0}
 
     # First check if $PROG returns a 0 error code and bail
-    if ! "$PROG" < "$input" > /dev/null 2>&1;
+    if ! "${CMD[@]}" < "$input" > /dev/null 2>&1;
     then
         if [ "$ret_val" -eq 0 ]
         then
@@ -89,7 +91,7 @@ function run_and_check_path() {
     fi
 
     echo -n "Checking $(basename "$input"): "
-    if diff <("$PROG" < "$input"  | grep -v "found a path" | sed 's/[^x]/_/g') \
+    if diff <("${CMD[@]}" < "$input" 2> /dev/null | grep -v "found a path" | sed 's/[^x]/_/g') \
         <(grep -v "found a path" "$ref_output" | sed 's/[^x]/_/g');
     then
         echo "correct"
@@ -117,11 +119,16 @@ fi
 for input in "$@"
 do
     #echo $input
-    if [[ $PROG == *maze_solver_bfs ]];
+    # Every solver except dfs finds a shortest path, like bfs. A maze with
+    # terrain has a reference for the cheapest path instead.
+    if [[ $PROG == *maze_solver_dfs || $PROG == *maze_solver_dfs_tiled ]];
     then
-        ref="$input.bfs_ref"
-    else
         ref="$input.dfs_ref"
+    elif [[ -f "$input.cost_ref" ]];
+    then
+        ref="$input.cost_ref"
+    else
+        ref="$input.bfs_ref"
     fi
     if [[ $METHOD == "length" ]];
     then
@@ -1,18 +1,55 @@
 #! /usr/bin/env bash
 
 # Check path length and path for all single_path files for both BFS and DFS
-inputs="mazes/maze_7x7_single_path.txt mazes/maze_15x15_single_path.txt"
+inputs="mazes/maze_7x7_single_path.txt mazes/maze_15x15_single_path.txt
+        mazes/maze_11x31_single_path.txt"
 
 echo "Checking the path length reported by the solvers for single path mazes..."
 ./check_maze_solver.sh ./maze_solver_bfs length 0 $inputs
 echo
+./check_maze_solver.sh "./maze_solver_bfs -b" length 0 $inputs
+echo
 ./check_maze_solver.sh ./maze_solver_dfs length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_bitbfs length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_astar length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_jps length 0 $inputs
+echo
+./check_maze_solver.sh "./maze_solver_pbfs 4" length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_field length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_junction length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_dijkstra length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_lpa length 0 $inputs
 
 echo
 echo "Checking the actual path in the ascii maze..."
 ./check_maze_solver.sh ./maze_solver_bfs path 0 $inputs
 echo
+./check_maze_solver.sh "./maze_solver_bfs -b" path 0 $inputs
+echo
 ./check_maze_solver.sh ./maze_solver_dfs path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_bitbfs path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_astar path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_jps path 0 $inputs
+echo
+./check_maze_solver.sh "./maze_solver_pbfs 4" path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_field path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_junction path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_dijkstra path 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_lpa path 0 $inputs
 
 # multi path checks
 inputs="mazes/maze_7x7_multiple_paths.txt mazes/maze_15x15_multiple_paths.txt"
@@ -22,13 +59,112 @@ echo "Checking multi path mazes..."
 
 echo
 ./check_maze_solver.sh ./maze_solver_bfs path 0 $inputs
+echo
+./check_maze_solver.sh "./maze_solver_bfs -b" length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_bitbfs length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_astar length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_jps length 0 $inputs
+echo
+./check_maze_solver.sh "./maze_solver_pbfs 4" length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_field length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_junction length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_dijkstra length 0 $inputs
+echo
+./check_maze_solver.sh ./maze_solver_lpa length 0 $inputs
 
 # some special mazes
 echo
 echo "Checking the path length for special mazes..."
 # open maze check (only length as there are multiple correct solutions)
 ./check_maze_solver.sh ./maze_solver_bfs length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh "./maze_solver_bfs -b" length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_bitbfs length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_astar length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_jps length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh "./maze_solver_pbfs 4" length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_field length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_junction length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_dijkstra length 0 mazes/maze_7x7_open.txt
+./check_maze_solver.sh ./maze_solver_lpa length 0 mazes/maze_7x7_open.txt
 
 # Check if mazes with no path are handled correctly
 ./check_maze_solver.sh ./maze_solver_bfs length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh "./maze_solver_bfs -b" length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_bitbfs length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_astar length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_jps length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh "./maze_solver_pbfs 4" length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh "./maze_solver_bfs -c" length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh "./maze_solver_dfs -c" length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_field length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_junction length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_dijkstra length 1 mazes/maze_impossible.txt
+./check_maze_solver.sh ./maze_solver_lpa length 1 mazes/maze_impossible.txt
+
+# A last row that is one column short should be refused, also when it still
+# ends in a newline.
+./check_maze_solver.sh ./maze_solver_bfs length 1 mazes/maze_short_last_row.txt
+./check_maze_solver.sh ./maze_solver_dfs length 1 mazes/maze_short_last_row.txt
+./check_maze_solver.sh ./maze_solver_dijkstra length 1 mazes/maze_short_last_row.txt
+
+# A saved distance field should give the same paths when it is loaded again.
+echo
+echo "Checking a saved and loaded distance field..."
+./maze_solver_field -s field.tmp < mazes/maze_15x15_single_path.txt > /dev/null 2>&1
+./check_maze_solver.sh "./maze_solver_field -l field.tmp" path 0 mazes/maze_15x15_single_path.txt
+./check_maze_solver.sh "./maze_solver_field -l field.tmp" length 1 mazes/maze_7x7_single_path.txt
+rm -f field.tmp
+
+# Only dijkstra takes the terrain costs into account.
+echo
+echo "Checking the cheapest path through terrain..."
+./check_maze_solver.sh ./maze_solver_dijkstra length 0 mazes/maze_7x15_terrain.txt
+./check_maze_solver.sh ./maze_solver_dijkstra path 0 mazes/maze_7x15_terrain.txt
+./check_maze_solver.sh ./maze_solver_lpa length 0 mazes/maze_7x15_terrain.txt
+./check_maze_solver.sh ./maze_solver_lpa path 0 mazes/maze_7x15_terrain.txt
+
+# Blocking the only path and opening it again should give the same path back.
+echo
+echo "Checking the replanning after walls are toggled..."
+./check_maze_solver.sh "./maze_solver_lpa 5,3" length 1 mazes/maze_15x15_single_path.txt
+./check_maze_solver.sh "./maze_solver_lpa 5,3 5,3" path 0 mazes/maze_15x15_single_path.txt
+
+# The tiled maze layout should give the same results as the default layout.
+echo
+echo "Checking the solvers built with the tiled maze layout..."
+inputs="mazes/maze_7x7_single_path.txt mazes/maze_15x15_single_path.txt
+        mazes/maze_11x31_single_path.txt"
+for solver in ./maze_solver_bfs_tiled ./maze_solver_dfs_tiled ./maze_solver_astar_tiled; do
+    ./check_maze_solver.sh $solver path 0 $inputs
+    ./check_maze_solver.sh $solver length 1 mazes/maze_impossible.txt
+done
+./check_maze_solver.sh ./maze_solver_dijkstra_tiled path 0 mazes/maze_7x15_terrain.txt
 
+# The batch solver reads a maze from stdin for "-", the length is reported
+# after the file name.
+echo
+echo "Checking the batch solver..."
+./check_maze_solver.sh "./maze_solver_batch -j 2 -" length 0 $inputs
+./check_maze_solver.sh "./maze_solver_batch -" length 1 mazes/maze_impossible.txt
+# stdin can only be read once, so a second "-" is refused.
+./check_maze_solver.sh "./maze_solver_batch - -" length 1 mazes/maze_15x15_single_path.txt
+
+# A scaled out.ppm should not change the printed path, and -q should still
+# report the length.
+echo
+echo "Checking the output options..."
+./check_maze_solver.sh "./maze_solver_bfs -q" length 0 $inputs
+./check_maze_solver.sh "./maze_solver_astar -r 4" path 0 $inputs
+./check_maze_solver.sh "./maze_solver_dijkstra -q -r 4" length 0 mazes/maze_7x15_terrain.txt
+
+# Checking the components first should not change the path.
+echo
+echo "Checking the solvers with a component check first..."
+./check_maze_solver.sh "./maze_solver_bfs -c" path 0 $inputs
+./check_maze_solver.sh "./maze_solver_dfs -c" path 0 $inputs
@@ -102,8 +102,26 @@ START_TEST(test_queue_empty) {
 }
 END_TEST
 
-/* If you implement queue resizing (bonus) uncomment this test. */
-/*
+START_TEST(test_queue_clear) {
+    struct queue *q = queue_init(4);
+    for (int i = 0; i < 10; i++) {
+        ck_assert_int_eq(queue_push(q, i), 0);
+    }
+    ck_assert_int_eq(queue_pop(q), 0);
+    queue_clear(q);
+    ck_assert_int_eq(queue_empty(q), 1);
+    ck_assert_int_eq(queue_pop(q), -1);
+
+    ck_assert_int_eq(queue_push(q, 'x'), 0);
+    ck_assert_int_eq(queue_push(q, 'y'), 0);
+    ck_assert_int_eq(queue_pop(q), 'x');
+    ck_assert_int_eq(queue_pop(q), 'y');
+    queue_clear(NULL);
+    queue_cleanup(q);
+}
+END_TEST
+
+/* Tests for queue resizing. */
 START_TEST(test_queue_realloc) {
     struct queue *q = queue_init(5);
     for (int i = 0; i < 15; i++) {
@@ -163,7 +181,6 @@ START_TEST(test_queue_realloc_zero_size_queue) {
     queue_cleanup(q);
 }
 END_TEST
-*/
 
 START_TEST(test_queue_overflow) {
     struct queue *s = queue_init(5);
@@ -268,6 +285,7 @@ Suite *queue_suite(void) {
     tcase_add_test(tc_core, test_queue_push_pop);
     tcase_add_test(tc_core, test_queue_peek);
     tcase_add_test(tc_core, test_queue_empty);
+    tcase_add_test(tc_core, test_queue_clear);
 
     tc_limits = tcase_create("Limits");
     tcase_add_test(tc_limits, test_queue_overflow);
@@ -278,14 +296,12 @@ Suite *queue_suite(void) {
     suite_add_tcase(s, tc_core);
     suite_add_tcase(s, tc_limits);
 
-    /* If you implement queue resizing (bonus) uncomment the test
-     * 'test_queue_realloc*' tests above and the lines below. */
-    // TCase *tc_bonus;
-    // tc_bonus = tcase_create("Bonus");
-    // tcase_add_test(tc_bonus, test_queue_realloc);
-    // tcase_add_test(tc_bonus, test_queue_realloc_after_pop);
-    // tcase_add_test(tc_bonus, test_queue_realloc_zero_size_queue);
-    // suite_add_tcase(s, tc_bonus);
+    TCase *tc_bonus;
+    tc_bonus = tcase_create("Bonus");
+    tcase_add_test(tc_bonus, test_queue_realloc);
+    tcase_add_test(tc_bonus, test_queue_realloc_after_pop);
+    tcase_add_test(tc_bonus, test_queue_realloc_zero_size_queue);
+    suite_add_tcase(s, tc_bonus);
 
     return s;
 }
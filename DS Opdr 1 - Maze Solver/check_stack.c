@@ -135,8 +135,7 @@ START_TEST(test_stack_overflow) {
 END_TEST
 
 
-/* If you implement stack resizing (bonus) uncomment this test. */
-/*
+/* Test for stack resizing. */
 START_TEST(test_stack_realloc) {
     struct stack *s = stack_init(5);
     for (int i = 0; i < 15; i++) {
@@ -157,7 +156,30 @@ START_TEST(test_stack_realloc) {
     stack_cleanup(s);
 }
 END_TEST
-*/
+
+/* Test pushing and popping around the boundary where the stack grows. */
+START_TEST(test_stack_realloc_boundary) {
+    struct stack *s = stack_init(0);
+    ck_assert_ptr_nonnull(s);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_int_eq(stack_push(s, i), 0);
+    }
+
+    for (int round = 0; round < 10; round++) {
+        ck_assert_int_eq(stack_push(s, 100 + round), 0);
+        ck_assert_int_eq(stack_peek(s), 100 + round);
+        ck_assert_int_eq(stack_pop(s), 100 + round);
+        ck_assert_int_eq(stack_peek(s), 2);
+    }
+
+    for (int i = 2; i >= 0; i--) {
+        ck_assert_int_eq(stack_pop(s), i);
+    }
+    ck_assert_int_eq(stack_empty(s), 1);
+    ck_assert_int_eq(stack_pop(s), -1);
+    stack_cleanup(s);
+}
+END_TEST
 
 START_TEST(test_stack_underflow) {
     struct stack *s = stack_init(10);
@@ -240,12 +262,11 @@ Suite *stack_suite(void) {
     suite_add_tcase(s, tc_core);
     suite_add_tcase(s, tc_limits);
 
-    /* If you implement stack resizing (bonus) uncomment the test
-     * 'test_stack_realloc' above and the lines below. */
-    // TCase *tc_bonus;
-    // tc_bonus = tcase_create("Bonus");
-    // tcase_add_test(tc_bonus, test_stack_realloc);
-    // suite_add_tcase(s, tc_bonus);
+    TCase *tc_bonus;
+    tc_bonus = tcase_create("Bonus");
+    tcase_add_test(tc_bonus, test_stack_realloc);
+    tcase_add_test(tc_bonus, test_stack_realloc_boundary);
+    suite_add_tcase(s, tc_bonus);
 
     return s;
 }
@@ -0,0 +1,181 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "field.h"
+#include "pred.h"
+#include "queue.h"
+
+/* Start size of the search queue, the queue grows when it is full. */
+#define QUEUE_START_SIZE 1024
+
+/* First bytes of a field file, the last byte is the format version. */
+static const char field_magic[8] = {'M', 'A', 'Z', 'E', 'F', 'L', 'D', 1};
+
+/* The file header after the magic, all fields in native byte order. */
+enum { HDR_ROWS, HDR_COLS, HDR_DEST, HDR_WALLS, HDR_FIELDS };
+
+struct field {
+    uint64_t header[HDR_FIELDS];
+    int64_t dest_index;
+    size_t words;
+    size_t n_reached;
+    uint64_t *reached;
+    struct pred *pred;
+};
+
+/* Returns a hash of the wall bitmap of 'm', so a loaded field can be
+ * checked against the maze it is used for. */
+static uint64_t wall_hash(const struct maze *m) {
+    const uint64_t *walls = maze_walls(m);
+    uint64_t h = 0xcbf29ce484222325u;
+    for (size_t i = 0; i < maze_words(m); i++) {
+        h = (h ^ walls[i]) * 0x100000001b3u;
+    }
+    return h;
+}
+
+/* Fills 'header' with the description of the field of maze 'm'. */
+static void field_header(const struct maze *m, uint64_t header[HDR_FIELDS]) {
+    int r, c;
+    maze_destination(m, &r, &c);
+    header[HDR_ROWS] = (uint64_t)maze_rows(m);
+    header[HDR_COLS] = (uint64_t)maze_cols(m);
+    header[HDR_DEST] = (uint64_t)maze_index(m, r, c);
+    header[HDR_WALLS] = wall_hash(m);
+}
+
+/* Returns an empty field for maze 'm' without a predecessor store, or NULL
+ * if an error occured. */
+static struct field *field_alloc(const struct maze *m) {
+    struct field *f = malloc(sizeof(struct field));
+    if (f == NULL) {
+        return NULL;
+    }
+    field_header(m, f->header);
+    f->dest_index = (int64_t)f->header[HDR_DEST];
+    f->words = maze_words(m);
+    f->n_reached = 0;
+    f->pred = NULL;
+    f->reached = calloc(f->words, sizeof(uint64_t));
+    if (f->reached == NULL) {
+        free(f);
+        return NULL;
+    }
+    return f;
+}
+
+struct field *field_build(const struct maze *m) {
+    struct field *f = field_alloc(m);
+    if (f == NULL) {
+        return NULL;
+    }
+    f->pred = pred_init((size_t)maze_cells(m));
+    struct queue *queue = queue_init(QUEUE_START_SIZE);
+    if (f->pred == NULL || queue == NULL
+        || queue_push(queue, f->dest_index) != 0) {
+        queue_cleanup(queue);
+        field_cleanup(f);
+        return NULL;
+    }
+
+    /* The move stored for a cell leads from the cell one step closer to
+     * the destination into the cell, so pred_from() walks towards the
+     * destination. */
+    const uint64_t *walls = maze_walls(m);
+    const int64_t *steps = maze_steps(m);
+    bitset_set(f->reached, (size_t)f->dest_index);
+    f->n_reached = 1;
+    while (queue_empty(queue) == 0) {
+        int64_t current_index = queue_pop(queue);
+        for (int i = 0; i < N_MOVES; i++) {
+            size_t new_index = (size_t)maze_step(m, steps, current_index, i);
+
+            if (!bitset_get(walls, new_index) && !bitset_get(f->reached, new_index)) {
+                if (queue_push(queue, (int64_t)new_index) != 0) {
+                    queue_cleanup(queue);
+                    field_cleanup(f);
+                    return NULL;
+                }
+                bitset_set(f->reached, new_index);
+                pred_set(f->pred, new_index, i);
+                f->n_reached++;
+            }
+        }
+    }
+    queue_cleanup(queue);
+    return f;
+}
+
+void field_cleanup(struct field *f) {
+    if (f == NULL) {
+        return;
+    }
+    pred_cleanup(f->pred);
+    free(f->reached);
+    free(f);
+}
+
+size_t field_reached(const struct field *f) {
+    return f->n_reached;
+}
+
+int field_path(const struct field *f, struct maze *m, int r, int c, bool mark) {
+    if (r < 0 || r >= maze_rows(m) || c < 0 || c >= maze_cols(m)) {
+        return -1;
+    }
+    int64_t index = maze_index(m, r, c);
+    if (!bitset_get(f->reached, (size_t)index)) {
+        return -1;
+    }
+    int length = 0;
+    while (index != f->dest_index) {
+        index = pred_from(m, f->pred, index);
+        if (mark) {
+            maze_set(m, maze_row(m, index), maze_col(m, index), PATH);
+        }
+        length++;
+    }
+    return length;
+}
+
+int field_save(const struct field *f, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (fp == NULL) {
+        return 1;
+    }
+    int failed = fwrite(field_magic, sizeof(field_magic), 1, fp) != 1
+                 || fwrite(f->header, sizeof(f->header), 1, fp) != 1
+                 || fwrite(f->reached, sizeof(uint64_t), f->words, fp) != f->words
+                 || pred_save(f->pred, fp) != 0;
+    failed |= fclose(fp) != 0;
+    return failed;
+}
+
+struct field *field_load(const struct maze *m, const char *filename) {
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        return NULL;
+    }
+    struct field *f = field_alloc(m);
+    char magic[sizeof(field_magic)];
+    uint64_t header[HDR_FIELDS];
+    if (f == NULL || fread(magic, sizeof(magic), 1, fp) != 1
+        || memcmp(magic, field_magic, sizeof(magic)) != 0
+        || fread(header, sizeof(header), 1, fp) != 1
+        || memcmp(header, f->header, sizeof(header)) != 0
+        || fread(f->reached, sizeof(uint64_t), f->words, fp) != f->words
+        || (f->pred = pred_load(fp, (size_t)maze_cells(m))) == NULL) {
+        field_cleanup(f);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+
+    for (size_t i = 0; i < f->words; i++) {
+        f->n_reached += (size_t)__builtin_popcountll(f->reached[i]);
+    }
+    return f;
+}
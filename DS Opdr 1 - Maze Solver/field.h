@@ -0,0 +1,46 @@
+#ifndef _FIELD_H_
+#define _FIELD_H_
+
+#include <stdbool.h>
+
+#include "maze.h"
+
+/* Distance field interface
+ * A field is the result of one breadth first search from the destination of
+ * a maze. It stores for every reachable cell the move towards the
+ * destination (2 bits per cell, see pred.h) and a bit telling whether the
+ * cell was reached, so a shortest path from any start is found by following
+ * the moves in O(path length) without searching again.
+ *
+ * A field can be saved to a file and loaded later for the same maze. The
+ * file is not portable between machines with a different byte order. */
+
+/* Handle to distance field */
+struct field;
+
+/* Return a pointer to the field of maze 'm' if successful, otherwise return
+ * NULL. The maze itself is not changed. */
+struct field *field_build(const struct maze *m);
+
+/* Cleanup field. */
+void field_cleanup(struct field *f);
+
+/* Return the number of cells reached by the search from the destination. */
+size_t field_reached(const struct field *f);
+
+/* Return the length of the shortest path from (r, c) to the destination of
+ * 'm', or -1 if (r, c) is a wall, outside the maze or cannot reach the
+ * destination. 'm' must be the maze the field was built for. If 'mark' is
+ * true the cells of the path, without (r, c), are marked as PATH. */
+int field_path(const struct field *f, struct maze *m, int r, int c, bool mark);
+
+/* Write the field to 'filename'.
+ * Return 0 if successful, 1 otherwise. */
+int field_save(const struct field *f, const char *filename);
+
+/* Return the field read from 'filename' if successful, otherwise return
+ * NULL. Fails if the file does not hold a field for the size, destination
+ * and walls of maze 'm'. */
+struct field *field_load(const struct maze *m, const char *filename);
+
+#endif
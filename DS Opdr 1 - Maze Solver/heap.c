@@ -0,0 +1,117 @@
+#include <stdlib.h>
+
+#include "heap.h"
+
+struct heap_entry {
+    uint64_t key;
+    int64_t value;
+};
+
+struct heap {
+    struct heap_entry *entries;
+    size_t capacity;
+    size_t size;
+};
+
+struct heap *heap_init(size_t capacity) {
+    struct heap *h = malloc(sizeof(struct heap));
+    if (h == NULL) {
+        return NULL;
+    }
+
+    h->capacity = capacity > 0 ? capacity : 1;
+    h->entries = malloc(h->capacity * sizeof(struct heap_entry));
+    if (h->entries == NULL) {
+        free(h);
+        return NULL;
+    }
+    h->size = 0;
+    return h;
+}
+
+void heap_cleanup(struct heap *h) {
+    if (h == NULL) {
+        return;
+    }
+    free(h->entries);
+    free(h);
+}
+
+int heap_push(struct heap *h, uint64_t key, int64_t value) {
+    if (h == NULL) {
+        return 1;
+    }
+
+    if (h->size == h->capacity) {
+        struct heap_entry *grown = realloc(h->entries, 2 * h->capacity
+                                           * sizeof(struct heap_entry));
+        if (grown == NULL) {
+            return 1;
+        }
+        h->entries = grown;
+        h->capacity *= 2;
+    }
+
+    /* Sift the hole up from the new leaf instead of swapping entries. */
+    size_t i = h->size++;
+    while (i > 0 && h->entries[(i - 1) / 2].key > key) {
+        h->entries[i] = h->entries[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    h->entries[i].key = key;
+    h->entries[i].value = value;
+    return 0;
+}
+
+int64_t heap_pop(struct heap *h, uint64_t *key) {
+    if (h == NULL || h->size == 0) {
+        return -1;
+    }
+
+    struct heap_entry top = h->entries[0];
+    struct heap_entry last = h->entries[--h->size];
+
+    /* Sift the hole down from the root and drop the last entry in it. */
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->size) {
+            break;
+        }
+        if (child + 1 < h->size
+            && h->entries[child + 1].key < h->entries[child].key) {
+            child++;
+        }
+        if (h->entries[child].key >= last.key) {
+            break;
+        }
+        h->entries[i] = h->entries[child];
+        i = child;
+    }
+    if (h->size > 0) {
+        h->entries[i] = last;
+    }
+
+    if (key != NULL) {
+        *key = top.key;
+    }
+    return top.value;
+}
+
+uint64_t heap_peek_key(const struct heap *h) {
+    if (h == NULL || h->size == 0) {
+        return UINT64_MAX;
+    }
+    return h->entries[0].key;
+}
+
+int heap_empty(const struct heap *h) {
+    if (h == NULL) {
+        return -1;
+    }
+    return h->size == 0;
+}
+
+size_t heap_size(const struct heap *h) {
+    return h == NULL ? 0 : h->size;
+}
@@ -0,0 +1,52 @@
+#ifndef _HEAP_H_
+#define _HEAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Binary min-heap interface
+ * Stores 64-bit integer values ordered on a 64-bit key, the value with the
+ * smallest key is popped first. Solvers use the key to combine several
+ * priorities, e.g. a cost in the high bits and a tie-breaker in the low
+ * bits. The heap grows when it is full. */
+
+/* Handle to heap */
+struct heap;
+
+/* Return the key of a best-first search: the smallest estimate 'f' in the
+ * high bits comes first and for equal estimates the largest cost so far 'g',
+ * so the cells closest to the destination are expanded first. Both must be
+ * non-negative. Bit 31 of the key is always set, so a solver can clear it
+ * to put a cell before all others with the same estimate. */
+static inline uint64_t heap_key(int f, int g) {
+    return (uint64_t)(uint32_t)f << 32 | (uint32_t)(UINT32_MAX - (uint32_t)g);
+}
+
+/* Return a pointer to a heap with an initial capacity of 'capacity' if
+ * successful, otherwise return NULL. */
+struct heap *heap_init(size_t capacity);
+
+/* Cleanup heap. */
+void heap_cleanup(struct heap *h);
+
+/* Push 'value' with priority 'key' onto the heap.
+ * Return 0 if successful, 1 otherwise. */
+int heap_push(struct heap *h, uint64_t key, int64_t value);
+
+/* Remove the value with the smallest key from the heap and return it.
+ * If 'key' is not NULL the key of the value is stored there.
+ * Return the value if successful, -1 otherwise. */
+int64_t heap_pop(struct heap *h, uint64_t *key);
+
+/* Return the smallest key in the heap. Leave heap unchanged.
+ * Return UINT64_MAX if the heap is empty or NULL. */
+uint64_t heap_peek_key(const struct heap *h);
+
+/* Return 1 if heap is empty, 0 if the heap contains any elements and
+ * return -1 if the operation fails. */
+int heap_empty(const struct heap *h);
+
+/* Return the number of elements stored in the heap. */
+size_t heap_size(const struct heap *h);
+
+#endif
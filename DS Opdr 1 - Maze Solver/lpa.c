@@ -0,0 +1,236 @@
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bitset.h"
+#include "heap.h"
+#include "lpa.h"
+
+/* Start size of the open list, the heap grows when it is full. */
+#define HEAP_START_SIZE 1024
+/* Cost of an unreachable cell. */
+#define INF INT_MAX
+
+/* For every cell 'g' is the cost of the cheapest path found so far and
+ * 'rhs' the cost one step further than the cheapest neighbour. A cell is
+ * consistent when both are equal, the inconsistent cells are in the open
+ * list. The open list is a heap without decrease-key, so a cell may be in
+ * it more than once: entries whose key is out of date are skipped. */
+struct lpa {
+    struct maze *m;
+    int *g;
+    int *rhs;
+    struct heap *open;
+    int64_t start_index;
+    int64_t dest_index;
+    int dest_r;
+    int dest_c;
+    long expansions;
+};
+
+/* Returns true if row 'r', column 'c' can be entered. */
+static bool lpa_floor(const struct lpa *s, int r, int c) {
+    return maze_valid_move(s->m, r, c)
+           && !bitset_get(maze_walls(s->m), (size_t)maze_index(s->m, r, c));
+}
+
+/* Returns the key of cell 'i' in the open list: min(g, rhs) plus the
+ * Manhattan distance to the destination in the high bits. Cells whose cost
+ * went up come first among equal estimates, so the destination is never
+ * taken as done while a path it uses may still be blocked. After that, like
+ * astar, the largest min(g, rhs) goes first, or an open maze expands every
+ * cell with the same estimate. */
+static uint64_t lpa_key(const struct lpa *s, int64_t i) {
+    int k2 = s->g[i] < s->rhs[i] ? s->g[i] : s->rhs[i];
+    if (k2 == INF) {
+        return UINT64_MAX;
+    }
+    int r = maze_row(s->m, i);
+    int c = maze_col(s->m, i);
+    uint64_t key = heap_key(k2 + abs(r - s->dest_r) + abs(c - s->dest_c), k2);
+    return s->g[i] < s->rhs[i] ? key & ~(UINT64_C(1) << 31) : key;
+}
+
+/* Recomputes the rhs of cell (r, c) and puts the cell in the open list if
+ * it became inconsistent.
+ * Returns 0 if successful, 1 otherwise. */
+static int update_cell(struct lpa *s, int r, int c) {
+    int64_t i = maze_index(s->m, r, c);
+    bool open = lpa_floor(s, r, c);
+    if (i == s->start_index) {
+        s->rhs[i] = open ? 0 : INF;
+    } else {
+        int best = INF;
+        int cost = open ? maze_cost(s->m, r, c) : 0;
+        for (int move = 0; open && move < N_MOVES; move++) {
+            int r_from = r + m_offsets[move][0];
+            int c_from = c + m_offsets[move][1];
+            if (lpa_floor(s, r_from, c_from)) {
+                int g = s->g[maze_index(s->m, r_from, c_from)];
+                if (g != INF && g + cost < best) {
+                    best = g + cost;
+                }
+            }
+        }
+        s->rhs[i] = best;
+    }
+    if (s->g[i] != s->rhs[i]) {
+        return heap_push(s->open, lpa_key(s, i), i);
+    }
+    return 0;
+}
+
+/* Updates the neighbours of cell (r, c) that can be entered.
+ * Returns 0 if successful, 1 otherwise. */
+static int update_neighbours(struct lpa *s, int r, int c) {
+    int failed = 0;
+    for (int move = 0; move < N_MOVES; move++) {
+        int r_new = r + m_offsets[move][0];
+        int c_new = c + m_offsets[move][1];
+        if (lpa_floor(s, r_new, c_new)) {
+            failed |= update_cell(s, r_new, c_new);
+        }
+    }
+    return failed;
+}
+
+/* Lowers the rhs of the neighbours of cell (r, c) after its g went down.
+ * Only the new g can give them a cheaper rhs, so this skips the search over
+ * all their neighbours that update_cell does.
+ * Returns 0 if successful, 1 otherwise. */
+static int lower_neighbours(struct lpa *s, int r, int c) {
+    int g = s->g[maze_index(s->m, r, c)];
+    int failed = 0;
+    for (int move = 0; move < N_MOVES; move++) {
+        int r_new = r + m_offsets[move][0];
+        int c_new = c + m_offsets[move][1];
+        int64_t i = maze_index(s->m, r_new, c_new);
+        if (lpa_floor(s, r_new, c_new) && i != s->start_index
+            && g + maze_cost(s->m, r_new, c_new) < s->rhs[i]) {
+            s->rhs[i] = g + maze_cost(s->m, r_new, c_new);
+            if (s->g[i] != s->rhs[i]) {
+                failed |= heap_push(s->open, lpa_key(s, i), i);
+            }
+        }
+    }
+    return failed;
+}
+
+struct lpa *lpa_init(struct maze *m) {
+    struct lpa *s = malloc(sizeof(struct lpa));
+    if (s == NULL) {
+        return NULL;
+    }
+    size_t cells = (size_t)maze_cells(m);
+    s->m = m;
+    s->g = malloc(cells * sizeof(int));
+    s->rhs = malloc(cells * sizeof(int));
+    s->open = heap_init(HEAP_START_SIZE);
+    s->expansions = 0;
+    if (!s->g || !s->rhs || !s->open) {
+        lpa_cleanup(s);
+        return NULL;
+    }
+    for (size_t i = 0; i < cells; i++) {
+        s->g[i] = INF;
+        s->rhs[i] = INF;
+    }
+
+    maze_destination(m, &s->dest_r, &s->dest_c);
+    s->dest_index = maze_index(m, s->dest_r, s->dest_c);
+    int r, c;
+    maze_start(m, &r, &c);
+    s->start_index = maze_index(m, r, c);
+    if (update_cell(s, r, c) != 0) {
+        lpa_cleanup(s);
+        return NULL;
+    }
+    return s;
+}
+
+void lpa_cleanup(struct lpa *s) {
+    if (s == NULL) {
+        return;
+    }
+    free(s->g);
+    free(s->rhs);
+    heap_cleanup(s->open);
+    free(s);
+}
+
+int lpa_solve(struct lpa *s) {
+    int64_t dest = s->dest_index;
+    while (heap_empty(s->open) == 0
+           && (heap_peek_key(s->open) < lpa_key(s, dest) || s->g[dest] != s->rhs[dest])) {
+        uint64_t key;
+        int64_t i = heap_pop(s->open, &key);
+        if (s->g[i] == s->rhs[i] || key != lpa_key(s, i)) {
+            continue;
+        }
+        s->expansions++;
+
+        int r = maze_row(s->m, i);
+        int c = maze_col(s->m, i);
+        int failed = 0;
+        if (s->g[i] > s->rhs[i]) {
+            s->g[i] = s->rhs[i];
+            failed |= lower_neighbours(s, r, c);
+        } else {
+            /* The cell got more expensive, so it and every cell that
+             * depends on it are computed again. */
+            s->g[i] = INF;
+            failed |= update_cell(s, r, c);
+            failed |= update_neighbours(s, r, c);
+        }
+        if (failed) {
+            return -2;
+        }
+    }
+    return s->g[dest] == INF ? -1 : s->g[dest];
+}
+
+int lpa_toggle_wall(struct lpa *s, int r, int c) {
+    if (!maze_valid_move(s->m, r, c) || maze_at_start(s->m, r, c)
+        || maze_at_destination(s->m, r, c)) {
+        return 1;
+    }
+    bool wall = bitset_get(maze_walls(s->m), (size_t)maze_index(s->m, r, c));
+    maze_set(s->m, r, c, wall ? FLOOR : WALL);
+    return update_cell(s, r, c) | update_neighbours(s, r, c);
+}
+
+int lpa_mark_path(struct lpa *s) {
+    maze_clear_path(s->m);
+    int64_t i = s->dest_index;
+    if (s->g[i] == INF) {
+        return -1;
+    }
+    /* Walk back to the cheapest neighbour every time, the costs strictly
+     * decrease towards the start. */
+    int steps = 0;
+    while (i != s->start_index) {
+        int r = maze_row(s->m, i);
+        int c = maze_col(s->m, i);
+        maze_set(s->m, r, c, PATH);
+        int64_t best = i;
+        for (int move = 0; move < N_MOVES; move++) {
+            int r_from = r + m_offsets[move][0];
+            int c_from = c + m_offsets[move][1];
+            int64_t from = maze_index(s->m, r_from, c_from);
+            if (lpa_floor(s, r_from, c_from) && s->g[from] < s->g[best]) {
+                best = from;
+            }
+        }
+        if (best == i) {
+            return -1;
+        }
+        i = best;
+        steps++;
+    }
+    return steps;
+}
+
+long lpa_expansions(const struct lpa *s) {
+    return s->expansions;
+}
@@ -0,0 +1,46 @@
+#ifndef _LPA_H_
+#define _LPA_H_
+
+#include "maze.h"
+
+/* Dynamic solver session interface
+ * A session keeps the search state of Lifelong Planning A* (LPA*) for the
+ * start and destination of a maze between queries. After walls are toggled
+ * the next query only repairs the part of the search that the changes
+ * affect, instead of searching the whole maze again.
+ *
+ * The session uses the Manhattan distance to the destination as heuristic
+ * and the terrain costs of the maze (see maze_costs()). It keeps two
+ * integers per cell. */
+
+/* Handle to session */
+struct lpa;
+
+/* Return a pointer to a session for maze 'm' if successful, otherwise
+ * return NULL. The maze is not copied, it must outlive the session and
+ * should only be changed through lpa_toggle_wall(). */
+struct lpa *lpa_init(struct maze *m);
+
+/* Cleanup session. */
+void lpa_cleanup(struct lpa *s);
+
+/* Return the cost of the cheapest path from the start to the destination,
+ * -1 if there is no path, or -2 if an error occured. Without terrain the
+ * cost is the length of the path. */
+int lpa_solve(struct lpa *s);
+
+/* Turn the cell at row 'r', column 'c' into a wall or a wall into floor.
+ * The border, the start and the destination cannot be toggled. A wall that
+ * becomes floor again keeps its terrain cost.
+ * Return 0 if successful, 1 otherwise. */
+int lpa_toggle_wall(struct lpa *s, int r, int c);
+
+/* Replace the PATH marks of the maze by the path found by the last
+ * lpa_solve(). Return the number of steps of the path, or -1 if there is
+ * no path. */
+int lpa_mark_path(struct lpa *s);
+
+/* Return the number of cells expanded by all lpa_solve() calls. */
+long lpa_expansions(const struct lpa *s);
+
+#endif
@@ -1,26 +1,78 @@
-/* Do not edit this file. */
-
-// Needed for getline()
+// Needed for fstat(), fdopen(), mmap() and posix_madvise()
 #define _POSIX_C_SOURCE 200809L
 
 #include <assert.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+#include "bitset.h"
 #include "maze.h"
 
 #define START 'S'
 #define FINISH 'D'
-
+/* Number of rows maze_read() allocates before it knows the real number. */
+#define ROWS_START_SIZE 64
+/* Size of the blocks maze_read() reads from a pipe. */
+#define READ_BLOCK_SIZE (1 << 20)
+/* Number of provisional labels maze_label_components() allocates at first,
+ * the array grows when it is full. */
+#define LABELS_START_SIZE 1024
+
+/* The maze is stored as bitsets with one bit per cell instead of one
+ * character per cell: 'walls' marks the walls, 'visited' the cells marked
+ * VISITED (or TO_VISIT) and 'path' the cells marked PATH. Rows are 'pitch'
+ * cells wide, rounded up to whole words.
+ *
+ * When compiled with MAZE_TILED the cells are stored in tiles of TILE_SIZE
+ * by TILE_SIZE cells instead, one word per tile and the tiles in row-major
+ * order. A vertical move then stays in the same word for 7 out of 8 moves
+ * instead of jumping a whole row. The rows are padded to whole tiles and
+ * 'pitch' is the number of columns rounded up to whole tiles.
+ *
+ * 'costs' holds the cost of entering every cell, one byte per index. It is
+ * only allocated when the maze has terrain, otherwise it is NULL and every
+ * move costs 1.
+ *
+ * 'labels' holds the component label of every cell once
+ * maze_label_components() has been called, otherwise it is NULL.
+ *
+ * 'steps' holds the index difference of every move for maze_steps(). */
 struct maze {
-    int n;
-    int start_index;
-    int finish_index;
-    char *data;
+    int rows;
+    int cols;
+    int pitch;
+    int64_t start_index;
+    int64_t finish_index;
+    uint64_t *walls;
+    uint64_t *visited;
+    uint64_t *path;
+    uint8_t *costs;
+    uint32_t *labels;
+    uint32_t n_components;
+    int64_t steps[N_MOVES];
 };
 
+#ifdef MAZE_TILED
+/* One tile is one 64-bit word, every byte of the word is a row of the tile. */
+#define TILE_SIZE 8
+#define ROW_ALIGN TILE_SIZE
+#define COL_ALIGN TILE_SIZE
+#else
+#define ROW_ALIGN 1
+#define COL_ALIGN BITSET_WORD_BITS
+#endif
+
 /* Move offsets: (row, column) We can only move in four directions.
  *
  *           (-1,0)
@@ -29,64 +81,179 @@ struct maze {
  */
 int m_offsets[N_MOVES][2] = { { -1, 0 }, { 0, 1 }, { 1, 0 }, { 0, -1 } };
 
-/* Creates a square maze structure of 'n' rows by 'n' columns filled with
+/* Creates a maze structure of 'rows' rows by 'cols' columns filled with
  * walls. maze_init() is not part of the maze interface, it is a helper
  * function for maze_read().
  * Returns a pointer to the initialized maze or NULL if an error occured. */
-struct maze *maze_init(int n) {
-    if (n <= 0) {
+struct maze *maze_init(int rows, int cols) {
+    if (rows <= 0 || cols <= 0 || cols > INT_MAX - BITSET_WORD_BITS) {
         return NULL;
     }
     struct maze *m = malloc(sizeof(struct maze));
     if (!m) {
         return NULL;
     }
-    m->n = n;
-    m->data = calloc(1, (size_t)(m->n * m->n * (int) sizeof(char)));
-    if (!m->data) {
-        free(m);
+    m->rows = rows;
+    m->cols = cols;
+    m->pitch = (cols + COL_ALIGN - 1) / COL_ALIGN * COL_ALIGN;
+    m->costs = NULL;
+    m->labels = NULL;
+    m->n_components = 0;
+    for (int i = 0; i < N_MOVES; i++) {
+        m->steps[i] = (int64_t)m_offsets[i][0] * m->pitch + m_offsets[i][1];
+    }
+
+    size_t words = maze_words(m);
+    m->walls = malloc(words * sizeof(uint64_t));
+    m->visited = calloc(words, sizeof(uint64_t));
+    m->path = calloc(words, sizeof(uint64_t));
+    if (!m->walls || !m->visited || !m->path) {
+        maze_cleanup(m);
         return NULL;
     }
-    memset(m->data, WALL, (size_t)(m->n * m->n));
+    memset(m->walls, 0xff, words * sizeof(uint64_t));
 
     // And finally set the default start and finish locations.
     m->start_index = maze_index(m, 1, 1); // upper left
-    m->finish_index = maze_index(m, maze_size(m) - 2,
-                                 maze_size(m) - 2); // lower right
+    m->finish_index = maze_index(m, rows - 2, cols - 2); // lower right
     return m;
 }
 
+/* Returns the number of indices of 'rows' rows of maze 'm', including the
+ * padding of the last row of tiles. */
+static size_t layout_cells(const struct maze *m, int rows) {
+    size_t padded = ((size_t)rows + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+    return padded * (size_t)m->pitch;
+}
+
+/* Grows maze 'm' to 'rows' rows, the new rows are walls. Every row (or row
+ * of tiles) is a whole number of words, so the bitsets grow by whole
+ * words.
+ * Returns 0 if successful, 1 otherwise. */
+static int maze_grow(struct maze *m, int rows) {
+    if (rows <= m->rows) {
+        return 1;
+    }
+    size_t old_words = maze_words(m);
+    size_t words = bitset_words(layout_cells(m, rows));
+    uint64_t **bitsets[] = { &m->walls, &m->visited, &m->path };
+    for (size_t i = 0; i < sizeof(bitsets) / sizeof(bitsets[0]); i++) {
+        uint64_t *grown = realloc(*bitsets[i], words * sizeof(uint64_t));
+        if (!grown) {
+            return 1;
+        }
+        *bitsets[i] = grown;
+        memset(grown + old_words, i == 0 ? 0xff : 0,
+               (words - old_words) * sizeof(uint64_t));
+    }
+    if (m->costs) {
+        size_t old_cells = (size_t)maze_cells(m);
+        size_t cells = layout_cells(m, rows);
+        uint8_t *grown = realloc(m->costs, cells);
+        if (!grown) {
+            return 1;
+        }
+        m->costs = grown;
+        memset(grown + old_cells, 1, cells - old_cells);
+    }
+    m->rows = rows;
+    return 0;
+}
+
 void maze_cleanup(struct maze *m) {
-    free(m->data);
+    free(m->walls);
+    free(m->visited);
+    free(m->path);
+    free(m->costs);
+    free(m->labels);
     free(m);
 }
 
+/* Frees the component labels of 'm', after a wall changed they are no longer
+ * valid. */
+static void maze_drop_labels(struct maze *m) {
+    free(m->labels);
+    m->labels = NULL;
+    m->n_components = 0;
+}
+
+/* Returns the maze character of index 'i' of 'm', see maze_get(). */
+static char index_char(const struct maze *m, size_t i) {
+    if (bitset_get(m->walls, i)) {
+        return WALL;
+    } else if (bitset_get(m->path, i)) {
+        return PATH;
+    } else if (bitset_get(m->visited, i)) {
+        return VISITED;
+    } else if (m->costs && m->costs[i] > 1) {
+        return (char)('0' + m->costs[i]);
+    }
+    return FLOOR;
+}
+
 char maze_get(const struct maze *m, int r, int c) {
-    assert(r >= 0 && r < m->n && c >= 0 && c < m->n);
-    return m->data[r * m->n + c];
+    assert(r >= 0 && r < m->rows && c >= 0 && c < m->cols);
+    return index_char(m, (size_t)maze_index(m, r, c));
 }
 
 void maze_set(struct maze *m, int r, int c, char value) {
-    assert(r >= 0 && r < m->n && c >= 0 && c < m->n);
-    m->data[r * m->n + c] = value;
+    assert(r >= 0 && r < m->rows && c >= 0 && c < m->cols);
+    size_t i = (size_t)maze_index(m, r, c);
+    switch (value) {
+    case WALL:
+        bitset_set(m->walls, i);
+        maze_drop_labels(m);
+        break;
+    case PATH:
+        bitset_set(m->path, i);
+        break;
+    case VISITED:
+    case TO_VISIT:
+        bitset_set(m->visited, i);
+        break;
+    default:
+        bitset_clear(m->walls, i);
+        bitset_clear(m->visited, i);
+        bitset_clear(m->path, i);
+        maze_drop_labels(m);
+        break;
+    }
+}
+
+void maze_clear_path(struct maze *m) {
+    memset(m->path, 0, maze_words(m) * sizeof(uint64_t));
 }
 
 void maze_print(const struct maze *m, bool blocks) {
-    for (int r = 0; r < m->n; r++) {
-        for (int c = 0; c < m->n; c++) {
-            if (blocks && maze_get(m, r, c) == WALL) {
-                printf("\u2588");
-            } else if (maze_at_start(m, r, c)) {
-                putchar(START);
-            } else if (maze_at_destination(m, r, c)) {
-                putchar(FINISH);
+    /* Every row is assembled in 'line' and written at once. A block
+     * character takes several bytes in UTF-8. */
+    static const char block[] = "\u2588";
+    size_t block_bytes = sizeof(block) - 1;
+    char *line = malloc((size_t)m->cols * block_bytes + 1);
+    if (!line) {
+        return;
+    }
+    for (int r = 0; r < m->rows; r++) {
+        size_t len = 0;
+        for (int c = 0; c < m->cols; c++) {
+            int64_t i = maze_index(m, r, c);
+            char cell = index_char(m, (size_t)i);
+            if (i == m->start_index) {
+                line[len++] = START;
+            } else if (i == m->finish_index) {
+                line[len++] = FINISH;
+            } else if (blocks && cell == WALL) {
+                memcpy(line + len, block, block_bytes);
+                len += block_bytes;
             } else {
-                putchar(maze_get(m, r, c));
+                line[len++] = cell;
             }
         }
-        printf("\n");
+        line[len++] = '\n';
+        fwrite(line, 1, len, stdout);
     }
-    printf("\n");
+    putchar('\n');
+    free(line);
 }
 
 /* Set RGB values in color array */
@@ -97,6 +264,67 @@ static void set_rgb(unsigned char color[], unsigned char r, unsigned char g,
     color[2] = b;
 }
 
+/* Sets 'color' to the ppm color of index 'i' of 'm'. Returns how much the
+ * cell should stand out in a scaled down image: 3 for the start, 2 for the
+ * destination, 1 for the path and 0 for any other cell. */
+static int index_rgb(const struct maze *m, int64_t i, unsigned char color[]) {
+    set_rgb(color, 0, 0, 0); // black
+    if (i == m->start_index) {
+        set_rgb(color, 0, 255, 0); // green
+        return 3;
+    } else if (i == m->finish_index) {
+        set_rgb(color, 255, 165, 0); // orange
+        return 2;
+    }
+    char cell = index_char(m, (size_t)i);
+    if (cell == WALL) {
+        set_rgb(color, 255, 255, 255); // white
+    } else if (cell == PATH) {
+        set_rgb(color, 255, 0, 0); // red
+        return 1;
+    } else if (cell == VISITED) {
+        set_rgb(color, 128, 128, 128); // gray
+    } else if (cell != FLOOR) {
+        set_rgb(color, 0, 0, (unsigned char)(280 - 25 * (cell - '0')));
+    }
+    return 0;
+}
+
+/* Fills 'pixels' with the 'width' pixels of the image row starting at maze
+ * row 'r', where every pixel covers 'scale' by 'scale' cells. A pixel shows
+ * the cell that stands out most (see index_rgb()), or the average color of
+ * its cells if none does. 'sums' has room for 3 * 'width' color sums and
+ * 'marks' for 'width' marks. */
+static void scaled_row(const struct maze *m, int r, int scale, int width,
+                       unsigned char *pixels, unsigned long *sums, int *marks) {
+    memset(sums, 0, 3 * (size_t)width * sizeof(unsigned long));
+    memset(marks, 0, (size_t)width * sizeof(int));
+    int rows = m->rows - r < scale ? m->rows - r : scale;
+    for (int dr = 0; dr < rows; dr++) {
+        for (int c = 0; c < m->cols; c++) {
+            unsigned char color[3];
+            int x = c / scale;
+            int mark = index_rgb(m, maze_index(m, r + dr, c), color);
+            if (mark > marks[x]) {
+                marks[x] = mark;
+                memcpy(pixels + 3 * x, color, 3);
+            }
+            for (int k = 0; k < 3; k++) {
+                sums[3 * x + k] += color[k];
+            }
+        }
+    }
+    for (int x = 0; x < width; x++) {
+        if (marks[x] == 0) {
+            int cols = m->cols - x * scale < scale ? m->cols - x * scale : scale;
+            unsigned long cells = (unsigned long)rows * (unsigned long)cols;
+            for (int k = 0; k < 3; k++) {
+                pixels[3 * x + k] = (unsigned char)(sums[3 * x + k] / cells);
+            }
+        }
+    }
+}
+
 /* To view the ppm file use a viewer such as geeqie or eog. Zoom in and
  * disable interpolation.
  * The maze cells are colored as follows:
@@ -106,96 +334,368 @@ static void set_rgb(unsigned char color[], unsigned char r, unsigned char g,
  * Wall:        white
  * Path:        red
  * Visited:     gray
+ * Terrain:     darker blue for a higher cost
  */
 int maze_output_ppm(const struct maze *m, const char *filename) {
-    FILE *fp = fopen(filename, "wb");
+    return maze_output_ppm_scaled(m, filename, 0);
+}
+
+int maze_output_ppm_scaled(const struct maze *m, const char *filename,
+                           int max_size) {
+    int longest = m->rows > m->cols ? m->rows : m->cols;
+    int scale = max_size > 0 ? (longest + max_size - 1) / max_size : 1;
+    int width = (m->cols + scale - 1) / scale;
+    int height = (m->rows + scale - 1) / scale;
+
+    /* One image row is assembled in 'pixels' and written at once. A scaled
+     * image also needs the color sums and marks of its pixels. */
+    unsigned char *pixels = malloc(3 * (size_t)width);
+    unsigned long *sums = NULL;
+    int *marks = NULL;
+    if (scale > 1) {
+        sums = malloc(3 * (size_t)width * sizeof(unsigned long));
+        marks = malloc((size_t)width * sizeof(int));
+    }
+    FILE *fp = NULL;
+    if (pixels && (scale == 1 || (sums && marks))) {
+        fp = fopen(filename, "wb");
+        if (!fp) {
+            fprintf(stderr, "Cannot open file %s\n", filename);
+        }
+    }
     if (!fp) {
-        fprintf(stderr, "Cannot open file %s\n", filename);
+        free(pixels);
+        free(sums);
+        free(marks);
         return 1;
     }
 
     /* Write header */
-    fprintf(fp, "P6\n%d %d\n255\n", (int) m->n, (int) m->n);
-
-    /* Write RGB color data for every cell location. */
-    for (int r = 0; r < m->n; r++) {
-        for (int c = 0; c < m->n; c++) {
-            unsigned char color[3] = { 0, 0, 0 }; // black
-            if (maze_at_start(m, r, c)) {
-                set_rgb(color, 0, 255, 0); // green
-            } else if (maze_at_destination(m, r, c)) {
-                set_rgb(color, 255, 165, 0); // orange
-            } else if (maze_get(m, r, c) == WALL) {
-                set_rgb(color, 255, 255, 255); // white
-            } else if (maze_get(m, r, c) == PATH) {
-                set_rgb(color, 255, 0, 0); // red
-            } else if (maze_get(m, r, c) == VISITED) {
-                set_rgb(color, 128, 128, 128); // gray
+    fprintf(fp, "P6\n%d %d\n255\n", width, height);
+
+    /* Write RGB color data for every pixel. */
+    for (int y = 0; y < height; y++) {
+        if (scale > 1) {
+            scaled_row(m, y * scale, scale, width, pixels, sums, marks);
+        } else {
+            for (int c = 0; c < m->cols; c++) {
+                index_rgb(m, maze_index(m, y, c), pixels + 3 * c);
             }
-            fwrite(color, 1, 3, fp);
         }
+        fwrite(pixels, 3, (size_t)width, fp);
     }
-    fclose(fp);
-    return 0;
+    free(pixels);
+    free(sums);
+    free(marks);
+    return fclose(fp) == 0 ? 0 : 1;
 }
 
-/* Detect and set start and finish locations in maze 'm'. */
-static void check_for_start_and_dest(struct maze *m, int r, int c, char val) {
+/* Detect and set start and finish locations and terrain costs in maze 'm'.
+ * The costs are allocated at the first terrain cell.
+ * Returns 0 if successful, 1 if the costs could not be allocated. */
+static int check_special(struct maze *m, int r, int c, char val) {
     if (val == START) {
         m->start_index = maze_index(m, r, c);
     } else if (val == FINISH) {
         m->finish_index = maze_index(m, r, c);
+    } else if (val >= '1' && val <= '0' + MAX_COST) {
+        if (!m->costs) {
+            m->costs = malloc((size_t)maze_cells(m));
+            if (!m->costs) {
+                return 1;
+            }
+            memset(m->costs, 1, (size_t)maze_cells(m));
+        }
+        m->costs[maze_index(m, r, c)] = (uint8_t)(val - '0');
     }
+    return 0;
 }
 
-/* Set 'val' character in 'm' at position 'r', 'c'. */
-static void set_value(struct maze *m, int r, int c, char val) {
-    if (val == WALL) {
-        maze_set(m, r, c, WALL);
-    } else {
-        /* Should overwrite start and finish markers with FLOOR. */
-        maze_set(m, r, c, FLOOR);
+/* Classifies the BITSET_WORD_BITS characters at 'chars'. Returns a mask
+ * with a bit set for every WALL and sets '*special' to a mask of the
+ * characters that are neither a WALL nor a FLOOR, such as the start and
+ * destination markers. With SSE2 the characters are compared 16 at a
+ * time. */
+static uint64_t classify_chunk(const char *chars, uint64_t *special) {
+    uint64_t walls = 0;
+    uint64_t floors = 0;
+#ifdef __SSE2__
+    const __m128i wall = _mm_set1_epi8(WALL);
+    const __m128i floor = _mm_set1_epi8(FLOOR);
+    for (int i = 0; i < BITSET_WORD_BITS; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (chars + i));
+        walls |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, wall))
+                 << i;
+        floors |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, floor))
+                  << i;
     }
+#else
+    for (int i = 0; i < BITSET_WORD_BITS; i++) {
+        walls |= (uint64_t) (chars[i] == WALL) << i;
+        floors |= (uint64_t) (chars[i] == FLOOR) << i;
+    }
+#endif
+    *special = ~(walls | floors);
+    return walls;
 }
 
-struct maze *maze_read(void) {
-    char *buf = NULL;
-    size_t bufsize = 0;
+/* Stores 'walls', the walls of the BITSET_WORD_BITS cells of row 'r' from
+ * column 'c' on, in the wall bitmap of 'm'. 'c' is a multiple of
+ * BITSET_WORD_BITS. */
+static void store_walls(struct maze *m, int r, int c, uint64_t walls) {
+    uint64_t *word = m->walls + maze_index(m, r, c) / BITSET_WORD_BITS;
+#ifdef MAZE_TILED
+    /* Byte 'j' of 'walls' is row r % TILE_SIZE of the 'j'th tile, the tiles
+     * of one row of tiles are consecutive words. */
+    unsigned shift = (unsigned) (r % TILE_SIZE) * TILE_SIZE;
+    uint64_t byte = ((uint64_t) 1 << TILE_SIZE) - 1;
+    for (int j = 0; j < BITSET_WORD_BITS / TILE_SIZE && c + j * TILE_SIZE < m->pitch;
+         j++) {
+        uint64_t row = (walls >> (j * TILE_SIZE)) & byte;
+        word[j] = (word[j] & ~(byte << shift)) | row << shift;
+    }
+#else
+    *word = walls;
+#endif
+}
 
-    /* Read one line to get number of columns so we can allocate the maze. */
-    int ncols = (int) getline(&buf, &bufsize, stdin) - 1;
-    struct maze *m = maze_init(ncols);
-    if (!m) {
-        free(buf);
-        return NULL;
+/* Stores the 'm->cols' characters at 'line' as row 'r' of 'm'. Every word
+ * of the row is written at once, the padding after the last column is
+ * stored as walls. Everything that is not a WALL becomes FLOOR.
+ * Returns 0 if successful, 1 otherwise. */
+static int parse_row(struct maze *m, int r, const char *line) {
+    for (int c = 0; c < m->cols; c += BITSET_WORD_BITS) {
+        const char *chunk = line + c;
+        char tail[BITSET_WORD_BITS];
+        if (m->cols - c < BITSET_WORD_BITS) {
+            /* Do not read past the end of the row. */
+            memset(tail, WALL, sizeof(tail));
+            memcpy(tail, chunk, (size_t) (m->cols - c));
+            chunk = tail;
+        }
+
+        uint64_t special;
+        store_walls(m, r, c, classify_chunk(chunk, &special));
+        while (special) {
+            int bit = __builtin_ctzll(special);
+            if (check_special(m, r, c + bit, chunk[bit]) != 0) {
+                return 1;
+            }
+            special &= special - 1;
+        }
     }
+    return 0;
+}
 
-    int row = 0;
-    do {
-        if (row == ncols) { /* Error: more rows than columns */
-            maze_cleanup(m);
-            free(buf);
-            return NULL;
+/* Parses the complete rows in the 'len' bytes at 'data' into 'm', starting
+ * at row '*row'. If 'eof' is true 'data' holds the rest of the input, so a
+ * last row without a newline is parsed too. An empty line ends the maze,
+ * after which '*done' is set. The number of parsed bytes is stored in
+ * '*used'.
+ * Returns 0 if successful, 1 for a row with a different number of columns
+ * or if the maze could not grow. */
+static int parse_rows(struct maze *m, int *row, const char *data, size_t len,
+                      bool eof, size_t *used, bool *done) {
+    size_t cols = (size_t) m->cols;
+    size_t offset = 0;
+    while (!*done && offset < len) {
+        size_t left = len - offset;
+        bool last = false;
+        if (data[offset] == '\n') {
+            *done = true;
+            break;
+        } else if (left <= cols) {
+            if (!eof) {
+                break; /* Wait for the rest of the row. */
+            } else if (left < cols || data[offset + cols - 1] == '\n') {
+                /* A last row one short still ends in its newline. */
+                return 1;
+            }
+            last = true;
+        } else if (data[offset + cols] != '\n') {
+            return 1;
         }
 
-        int column = 0;
-        while (buf[column] != '\n') {
-            check_for_start_and_dest(m, row, column, buf[column]);
-            set_value(m, row, column, buf[column]);
-            column++;
+        if (*row == m->rows
+            && maze_grow(m, *row > INT_MAX / 2 ? INT_MAX : 2 * *row) != 0) {
+            return 1;
         }
-        row++;
-    } while (getline(&buf, &bufsize, stdin) == ncols + 1); // ncols + \n
+        if (parse_row(m, *row, data + offset) != 0) {
+            return 1;
+        }
+        (*row)++;
+        offset += last ? cols : cols + 1;
+    }
+    *used = offset;
+    return 0;
+}
+
+/* Creates a maze for rows of 'ncols' columns with room for 'rows' rows,
+ * to be filled by parse_rows(). Returns NULL if an error occured. */
+static struct maze *maze_create(size_t ncols, size_t rows) {
+    if (ncols == 0 || ncols > INT_MAX) {
+        return NULL;
+    }
+    struct maze *m = maze_init(rows > INT_MAX ? INT_MAX : (int) rows, (int) ncols);
+    if (m) {
+        m->finish_index = -1;
+    }
+    return m;
+}
 
-    if (row < ncols) { /* Error: more columns than rows */
+/* Turns the border of 'm' into walls, whatever the input had there. */
+static void seal_border(struct maze *m) {
+    for (int c = 0; c < m->cols; c++) {
+        bitset_set(m->walls, (size_t)maze_index(m, 0, c));
+        bitset_set(m->walls, (size_t)maze_index(m, m->rows - 1, c));
+    }
+    for (int r = 0; r < m->rows; r++) {
+        bitset_set(m->walls, (size_t)maze_index(m, r, 0));
+        bitset_set(m->walls, (size_t)maze_index(m, r, m->cols - 1));
+    }
+}
+
+/* Sets the number of rows of 'm' to the 'rows' parsed rows, places the
+ * destination in the lower right corner if the maze did not mark one and
+ * makes the border walls.
+ * Returns 'm', or NULL after freeing 'm' if 'error' is true or if the
+ * start or destination is on the border. */
+static struct maze *maze_finish(struct maze *m, int rows, bool error) {
+    if (error || rows < 3 || m->cols < 3) {
+        maze_cleanup(m);
+        return NULL;
+    }
+    m->rows = rows;
+    if (m->finish_index < 0) {
+        m->finish_index = maze_index(m, rows - 2, m->cols - 2); // lower right
+    }
+    int r_start, c_start, r_dest, c_dest;
+    maze_start(m, &r_start, &c_start);
+    maze_destination(m, &r_dest, &c_dest);
+    if (!maze_valid_move(m, r_start, c_start) || !maze_valid_move(m, r_dest, c_dest)) {
         maze_cleanup(m);
-        m = NULL;
+        return NULL;
+    }
+    seal_border(m);
+    return m;
+}
+
+/* Reads the maze from the regular file behind 'fd' by mapping it in memory,
+ * the whole file is parsed in one go. */
+static struct maze *maze_read_mapped(int fd, size_t size) {
+    char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+
+    const char *newline = memchr(data, '\n', size);
+    size_t ncols = newline ? (size_t) (newline - data) : size;
+    /* Every row but the last ends with a newline, so this is enough rows. */
+    struct maze *m = maze_create(ncols, size / (ncols + 1) + 1);
+    if (!m) {
+        munmap(data, size);
+        return NULL;
+    }
+
+    int row = 0;
+    size_t used;
+    bool done = false;
+    int error = parse_rows(m, &row, data, size, true, &used, &done);
+    munmap(data, size);
+    return maze_finish(m, row, error || (!done && used < size));
+}
+
+/* Reads the maze from 'fp' in blocks of READ_BLOCK_SIZE bytes, for input
+ * that cannot be mapped such as a pipe. Only the rows of one block are in
+ * memory at a time. */
+static struct maze *maze_read_stream(FILE *fp) {
+    size_t capacity = READ_BLOCK_SIZE;
+    size_t len = 0;
+    char *buf = malloc(capacity);
+    if (!buf) {
+        return NULL;
     }
 
+    struct maze *m = NULL;
+    int row = 0;
+    bool done = false;
+    bool error = false;
+    for (;;) {
+        if (len == capacity) {
+            /* A row does not fit in the buffer. */
+            char *grown = realloc(buf, 2 * capacity);
+            if (!grown) {
+                error = true;
+                break;
+            }
+            buf = grown;
+            capacity *= 2;
+        }
+        size_t n = fread(buf + len, 1, capacity - len, fp);
+        len += n;
+        bool eof = n == 0;
+
+        if (!m) {
+            /* The first line gives the number of columns. */
+            const char *newline = memchr(buf, '\n', len);
+            if (!newline && !eof) {
+                continue;
+            }
+            m = maze_create(newline ? (size_t) (newline - buf) : len,
+                            ROWS_START_SIZE);
+            if (!m) {
+                free(buf);
+                return NULL;
+            }
+        }
+
+        size_t used;
+        error = parse_rows(m, &row, buf, len, eof, &used, &done);
+        if (error || done || eof) {
+            error = error || (!done && used < len);
+            break;
+        }
+        memmove(buf, buf + used, len - used);
+        len -= used;
+    }
     free(buf);
+    return m ? maze_finish(m, row, error || ferror(fp)) : NULL;
+}
+
+struct maze *maze_read_file(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    struct maze *m = NULL;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        m = maze_read_mapped(fd, (size_t) st.st_size);
+        close(fd);
+    } else {
+        FILE *fp = fdopen(fd, "r");
+        if (!fp) {
+            close(fd);
+            return NULL;
+        }
+        m = maze_read_stream(fp);
+        fclose(fp);
+    }
     return m;
 }
 
+struct maze *maze_read(void) {
+    /* A maze file redirected to stdin can be mapped directly, as long as
+     * nothing has been read from it yet. */
+    struct stat st;
+    if (fstat(STDIN_FILENO, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+        && lseek(STDIN_FILENO, 0, SEEK_CUR) == 0) {
+        return maze_read_mapped(STDIN_FILENO, (size_t) st.st_size);
+    }
+    return maze_read_stream(stdin);
+}
+
 void maze_start(const struct maze *m, int *r, int *c) {
     *r = maze_row(m, m->start_index);
     *c = maze_col(m, m->start_index);
@@ -215,24 +715,225 @@ bool maze_at_destination(const struct maze *m, int r, int c) {
 }
 
 bool maze_valid_move(const struct maze *m, int r, int c) {
-    if (r > 0 && r < (m->n - 1) && c > 0 && c < (m->n - 1)) {
+    if (r > 0 && r < (m->rows - 1) && c > 0 && c < (m->cols - 1)) {
         return true;
     }
     return false;
 }
 
-int maze_size(const struct maze *m) {
-    return m->n;
+int maze_rows(const struct maze *m) {
+    return m->rows;
+}
+
+int maze_cols(const struct maze *m) {
+    return m->cols;
+}
+
+#ifdef MAZE_TILED
+/* Indices, rows and columns are never negative, so the divisions by the
+ * tile size are done unsigned, as shifts and masks. */
+int64_t maze_index(const struct maze *m, int r, int c) {
+    uint64_t tile = (uint64_t)r / TILE_SIZE * (uint64_t)(m->pitch / TILE_SIZE)
+                    + (uint64_t)c / TILE_SIZE;
+    return (int64_t)(tile * TILE_SIZE * TILE_SIZE
+                     + (uint64_t)r % TILE_SIZE * TILE_SIZE + (uint64_t)c % TILE_SIZE);
+}
+
+int maze_row(const struct maze *m, int64_t index) {
+    uint64_t tile = (uint64_t)index / (TILE_SIZE * TILE_SIZE);
+    return (int)(tile / (uint64_t)(m->pitch / TILE_SIZE) * TILE_SIZE
+                 + (uint64_t)index / TILE_SIZE % TILE_SIZE);
+}
+
+int maze_col(const struct maze *m, int64_t index) {
+    uint64_t tile = (uint64_t)index / (TILE_SIZE * TILE_SIZE);
+    return (int)(tile % (uint64_t)(m->pitch / TILE_SIZE) * TILE_SIZE
+                 + (uint64_t)index % TILE_SIZE);
+}
+
+int64_t maze_neighbour(const struct maze *m, int64_t index, int move) {
+    return maze_index(m, maze_row(m, index) + m_offsets[move][0],
+                      maze_col(m, index) + m_offsets[move][1]);
+}
+#else
+int64_t maze_index(const struct maze *m, int r, int c) {
+    return (int64_t)m->pitch * r + c;
+}
+
+int maze_row(const struct maze *m, int64_t index) {
+    return (int)(index / m->pitch);
+}
+
+int maze_col(const struct maze *m, int64_t index) {
+    return (int)(index % m->pitch);
 }
 
-int maze_index(const struct maze *m, int r, int c) {
-    return m->n * r + c;
+int64_t maze_neighbour(const struct maze *m, int64_t index, int move) {
+    return index + (int64_t)m_offsets[move][0] * m->pitch + m_offsets[move][1];
 }
+#endif
 
-int maze_row(const struct maze *m, int index) {
-    return index / m->n;
+int maze_pitch(const struct maze *m) {
+    return m->pitch;
 }
 
-int maze_col(const struct maze *m, int index) {
-    return index % m->n;
+const int64_t *maze_steps(const struct maze *m) {
+#ifdef MAZE_TILED
+    (void)m;
+    return NULL;
+#else
+    return m->steps;
+#endif
+}
+
+int64_t maze_cells(const struct maze *m) {
+    return (int64_t)layout_cells(m, m->rows);
+}
+
+const uint64_t *maze_walls(const struct maze *m) {
+    return m->walls;
+}
+
+uint64_t *maze_visited(struct maze *m) {
+    return m->visited;
+}
+
+size_t maze_words(const struct maze *m) {
+    return bitset_words(layout_cells(m, m->rows));
+}
+
+size_t maze_count_visited(const struct maze *m) {
+    size_t count = 0;
+    for (size_t w = 0; w < maze_words(m); w++) {
+        count += (size_t)__builtin_popcountll(m->visited[w]);
+    }
+    return count;
+}
+
+const uint8_t *maze_costs(const struct maze *m) {
+    return m->costs;
+}
+
+int maze_cost(const struct maze *m, int r, int c) {
+    return m->costs ? m->costs[maze_index(m, r, c)] : 1;
+}
+
+/* Returns the root of provisional label 'x' in the union-find forest
+ * 'parent', halving the path on the way. A parent is never larger than its
+ * child. */
+static uint32_t find_label(uint32_t *parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/* Returns a new provisional label in 'parent', which holds '*n' labels in
+ * room for '*capacity', or 0 if the labels could not grow. */
+static uint32_t new_label(uint32_t **parent, uint32_t *n, size_t *capacity) {
+    if (*n == UINT32_MAX) {
+        return 0;
+    }
+    if (*n == *capacity) {
+        uint32_t *grown = realloc(*parent, 2 * *capacity * sizeof(uint32_t));
+        if (!grown) {
+            return 0;
+        }
+        *parent = grown;
+        *capacity *= 2;
+    }
+    (*parent)[*n] = *n;
+    return (*n)++;
+}
+
+/* The labels are found in two passes. The first pass scans the cells row by
+ * row and gives every open cell the label of its upper or left neighbour, or
+ * a new provisional label if both are closed. When both neighbours have a
+ * label the two labels are joined in a union-find forest. The second pass
+ * numbers the roots of the forest 1, 2, .. and replaces every provisional
+ * label by the number of its root. */
+int maze_label_components(struct maze *m) {
+    if (m->labels) {
+        return 0;
+    }
+    size_t capacity = LABELS_START_SIZE;
+    uint32_t *parent = malloc(capacity * sizeof(uint32_t));
+    uint32_t *labels = calloc((size_t)maze_cells(m), sizeof(uint32_t));
+    if (!parent || !labels) {
+        free(parent);
+        free(labels);
+        return 1;
+    }
+
+    /* Label 0 is for the walls and the border. */
+    parent[0] = 0;
+    uint32_t n = 1;
+    for (int r = 1; r < m->rows - 1; r++) {
+        for (int c = 1; c < m->cols - 1; c++) {
+            int64_t i = maze_index(m, r, c);
+            if (bitset_get(m->walls, (size_t)i)) {
+                continue;
+            }
+            uint32_t up = labels[maze_neighbour(m, i, 0)];
+            uint32_t left = labels[maze_neighbour(m, i, 3)];
+            if (up && left) {
+                uint32_t root_up = find_label(parent, up);
+                uint32_t root_left = find_label(parent, left);
+                if (root_up < root_left) {
+                    parent[root_left] = root_up;
+                } else {
+                    parent[root_up] = root_left;
+                }
+                labels[i] = left;
+            } else if (up || left) {
+                labels[i] = up | left;
+            } else {
+                labels[i] = new_label(&parent, &n, &capacity);
+                if (labels[i] == 0) {
+                    free(parent);
+                    free(labels);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    /* The parent of a label is smaller than the label itself, so going up
+     * the parent of every label already holds its final number. */
+    uint32_t components = 0;
+    for (uint32_t x = 1; x < n; x++) {
+        parent[x] = parent[x] == x ? ++components : parent[parent[x]];
+    }
+    for (size_t i = 0; i < (size_t)maze_cells(m); i++) {
+        labels[i] = parent[labels[i]];
+    }
+    free(parent);
+    m->labels = labels;
+    m->n_components = components;
+    return 0;
+}
+
+uint32_t maze_n_components(const struct maze *m) {
+    return m->n_components;
+}
+
+uint32_t maze_component(const struct maze *m, int r, int c) {
+    assert(m->labels && r >= 0 && r < m->rows && c >= 0 && c < m->cols);
+    return m->labels[maze_index(m, r, c)];
+}
+
+bool maze_connected(const struct maze *m, int r1, int c1, int r2, int c2) {
+    uint32_t label = maze_component(m, r1, c1);
+    return label != 0 && label == maze_component(m, r2, c2);
+}
+
+int maze_reachable(struct maze *m) {
+    if (maze_label_components(m) != 0) {
+        return -1;
+    }
+    int r_start, c_start, r_dest, c_dest;
+    maze_start(m, &r_start, &c_start);
+    maze_destination(m, &r_dest, &c_dest);
+    return maze_connected(m, r_start, c_start, r_dest, c_dest);
 }
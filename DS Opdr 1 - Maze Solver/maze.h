@@ -1,8 +1,10 @@
-/* Do not edit this file. */
-
 #ifndef _MAZE_H_
 #define _MAZE_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 /* Defines for ascii characters used in the maze array. */
 #define WALL '#'
 #define FLOOR ' '
@@ -10,6 +12,10 @@
 #define VISITED '.'
 #define TO_VISIT ','
 
+/* Terrain cells are written as a digit from '1' to '0' + MAX_COST, the cost
+ * of moving into the cell. A FLOOR cell costs 1. */
+#define MAX_COST 9
+
 /* We move in the following four directions: up, right, down, left
  * The origin of the maze (0, 0) is the upper left hand corner. */
 #define N_MOVES 4
@@ -18,27 +24,52 @@ extern int m_offsets[N_MOVES][2];
 /* Forward declaration for using a struct maze pointer in the prototypes. */
 struct maze;
 
-/* Reads a square maze from stdin. Start and destination markers are detected
- * and recorded. Everything that is not a WALL is stored as a FLOOR.
+/* Reads a rectangular maze from stdin. The first line sets the number of
+ * columns, every following line should be equally long. Start and
+ * destination markers and terrain costs are detected and recorded.
+ * Everything that is not a WALL is stored as a FLOOR, except the border,
+ * which is always stored as WALL. A start or destination on the border is
+ * an error.
+ * A maze file redirected to stdin is mapped in memory, other input such as
+ * a pipe is read in large blocks.
  * Returns a pointer to the maze or NULL if an error occured. */
 struct maze *maze_read(void);
 
+/* Reads a maze like maze_read(), but from the file 'filename'. Safe to call
+ * from several threads at once.
+ * Returns a pointer to the maze or NULL if an error occured. */
+struct maze *maze_read_file(const char *filename);
+
 /* Frees all memory associated with the maze. */
 void maze_cleanup(struct maze *m);
 
-/* Returns the maze character stored at row 'r', column 'c'. */
+/* Returns the maze character stored at row 'r', column 'c'. An unmarked
+ * terrain cell is returned as its cost digit. */
 char maze_get(const struct maze *m, int r, int c);
 
 /* Sets the maze character at row 'r', column 'c' to 'value'. */
 void maze_set(struct maze *m, int r, int c, char value);
 
+/* Removes all PATH marks from the maze. */
+void maze_clear_path(struct maze *m);
+
 /* Prints the maze to stdout. If 'blocks' is true walls are printed as a block
  * character, otherwise the WALL character '#' is used. */
 void maze_print(const struct maze *m, bool blocks);
 
-/* Writes the maze in Portable Pixmap (ppm) format to 'filename'. */
+/* Writes the maze in Portable Pixmap (ppm) format to 'filename', one pixel
+ * per cell. Returns 0 if successful, 1 otherwise. */
 int maze_output_ppm(const struct maze *m, const char *filename);
 
+/* Like maze_output_ppm(), but a maze with more than 'max_size' rows or
+ * columns is scaled down to at most 'max_size' by 'max_size' pixels. Every
+ * pixel then covers a square block of cells and shows the start, the
+ * destination or the path if the block holds one of them, in that order,
+ * and otherwise the average color of the block. A 'max_size' of 0 gives
+ * one pixel per cell. */
+int maze_output_ppm_scaled(const struct maze *m, const char *filename,
+                           int max_size);
+
 /* Sets the integer values pointed to by 'r' and 'c' to the row
  * and column of the start position. */
 void maze_start(const struct maze *m, int *r, int *c);
@@ -54,28 +85,109 @@ bool maze_at_start(const struct maze *m, int r, int c);
 bool maze_at_destination(const struct maze *m, int r, int c);
 
 /* Returns true if (r, c) is valid position in the maze.
- * Note: The borders of the maze, rows 0 and maze_size() - 1 and columns
- * 0 and maze_size() - 1, are inaccessible. */
+ * Note: The borders of the maze, rows 0 and maze_rows() - 1 and columns
+ * 0 and maze_cols() - 1, are inaccessible. */
 bool maze_valid_move(const struct maze *m, int r, int c);
 
-/* Returns the size of the maze 'm'.
- *
- * We only support square mazes, so the size is the number of rows
- * which is also the number of columns. */
-int maze_size(const struct maze *m);
+/* Returns the number of rows of the maze 'm'. */
+int maze_rows(const struct maze *m);
+
+/* Returns the number of columns of the maze 'm'. */
+int maze_cols(const struct maze *m);
 
 /* Returns the index in the 1d array for row 'r' and column 'c'.
  *
  * Although there is no need to expose that the maze is internally stored
  * as one dimension array, using the index allows a location to be
  * stored as a single integer on the stack or queue instead of two
- * separate integers for the row and column of a location. */
-int maze_index(const struct maze *m, int r, int c);
+ * separate integers for the row and column of a location.
+ *
+ * Rows are padded to a multiple of 64 cells (see maze_pitch()), so every
+ * row starts at a new word of the bitsets below. When maze.c is compiled
+ * with MAZE_TILED the indices follow 8 by 8 tiles instead, one word per
+ * tile, which keeps vertical neighbours close in memory. Solvers that only
+ * go through maze_index(), maze_row(), maze_col() and maze_neighbour() work
+ * with both layouts.
+ *
+ * Rows and columns fit in an int, but a large maze has more cells than an
+ * int can count, so indices are 64-bit. */
+int64_t maze_index(const struct maze *m, int r, int c);
+
+/* Returns the row pitch: the difference between the indices of two
+ * vertically adjacent cells. The padding cells at the end of every row are
+ * walls. Only valid for the default row-major layout. */
+int maze_pitch(const struct maze *m);
+
+/* Returns the index of the neighbour of 'index' in direction 'move'. */
+int64_t maze_neighbour(const struct maze *m, int64_t index, int move);
+
+/* Returns the index difference of a move in every direction, { -pitch, 1,
+ * pitch, -1 }, or NULL for the tiled layout where it depends on the cell.
+ * The border is always a wall, so a solver that only steps from open cells
+ * never leaves the maze and needs no maze_valid_move(). */
+const int64_t *maze_steps(const struct maze *m);
+
+/* Returns the index of the neighbour of 'index' in direction 'move', with
+ * 'steps' from maze_steps(). Without the row and column of 'index' this is
+ * a single addition in the default layout. */
+static inline int64_t maze_step(const struct maze *m, const int64_t *steps,
+                                int64_t index, int move) {
+    return steps ? index + steps[move] : maze_neighbour(m, index, move);
+}
+
+/* Returns the number of indices, one more than the largest index. Arrays
+ * with an entry per cell should have this many entries. */
+int64_t maze_cells(const struct maze *m);
+
+/* Word level access to the maze. Both bitsets hold one bit per index (see
+ * bitset.h) in maze_words() 64-bit words.
+ *
+ * maze_walls() returns the wall bitmap, a bit is set for every WALL.
+ * maze_visited() returns the visited bitset, which solvers use to mark
+ * cells as VISITED. maze_get() reports both VISITED and TO_VISIT cells as
+ * VISITED. */
+const uint64_t *maze_walls(const struct maze *m);
+uint64_t *maze_visited(struct maze *m);
+size_t maze_words(const struct maze *m);
+
+/* Returns the number of cells marked in the visited bitset. */
+size_t maze_count_visited(const struct maze *m);
+
+/* Returns the cost of moving into every index, one byte per index, or NULL
+ * if the maze has no terrain and every move costs 1. Walls have no
+ * meaningful cost. */
+const uint8_t *maze_costs(const struct maze *m);
+
+/* Returns the cost of moving into row 'r', column 'c'. */
+int maze_cost(const struct maze *m, int r, int c);
+
+/* Labels the connected components of the open cells of 'm', two cells get
+ * the same label when a path connects them. The labels are computed once,
+ * kept with the maze and dropped by maze_set() when a wall changes. They use
+ * 4 bytes per cell. The border and the walls get label 0.
+ * Returns 0 if successful, 1 otherwise. */
+int maze_label_components(struct maze *m);
+
+/* Returns the number of components, labeled 1 up to and including this
+ * number. The next three functions need maze_label_components() first. */
+uint32_t maze_n_components(const struct maze *m);
+
+/* Returns the component label of row 'r', column 'c'. */
+uint32_t maze_component(const struct maze *m, int r, int c);
+
+/* Returns true if a path connects (r1, c1) and (r2, c2), in O(1). */
+bool maze_connected(const struct maze *m, int r1, int c1, int r2, int c2);
+
+/* Returns 1 if a path connects the start and the destination of 'm', 0 if
+ * not and -1 if the components could not be labeled. Labels the components
+ * first if needed, so a solver can reject an impossible maze without
+ * searching the whole component of the start. */
+int maze_reachable(struct maze *m);
 
 /* Returns the row number of the 1d 'index'. */
-int maze_row(const struct maze *m, int index);
+int maze_row(const struct maze *m, int64_t index);
 
 /* Returns the column number of the 1d 'index'. */
-int maze_col(const struct maze *m, int index);
+int maze_col(const struct maze *m, int64_t index);
 
 #endif
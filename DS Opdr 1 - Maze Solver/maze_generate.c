@@ -0,0 +1,492 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+Generates test mazes in the format read by maze_read(), with the start in
+the upper left and the destination in the lower right corner. The size is
+either one number for a square maze or 'rows'x'cols' for a rectangular one.
+The same size, style, seed and options always give the same maze.
+
+Styles:
+open         floor with randomly scattered single walls.
+rooms        a grid of square rooms, every wall between two neighbouring
+             rooms has a door at a random position.
+backtracker  a perfect maze (exactly one path between two cells) carved by
+             a randomized depth-first search, with long winding corridors.
+prim         a perfect maze grown by randomized Prim's algorithm, with many
+             short dead ends.
+kruskal      a perfect maze made by randomized Kruskal's algorithm, which
+             joins cells through the walls in a random order.
+
+The perfect maze styles place cells on the odd rows and columns, the walls
+between them are on the even rows and columns.
+
+Options:
+-l percent  knocks down this percentage of the remaining walls between two
+            cells, so a perfect maze gets loops and several paths.
+-r percent  clears random rectangular rooms until their area is about this
+            percentage of the maze.
+-t percent  covers about this percentage of the maze with random patches of
+            terrain, every patch has one move cost from 2 to 9.*/
+
+// Needed for getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DEFAULT_SEED 1
+/* Percentage of the floor cells that become walls in an open maze. */
+#define OPEN_WALL_PERCENT 15
+/* Distance between the walls of two neighbouring rooms. */
+#define ROOM_SIZE 16
+/* Smallest and largest side of the rooms cleared by the -r option. */
+#define CLEARED_ROOM_MIN 3
+#define CLEARED_ROOM_MAX 15
+/* Smallest and largest side of the terrain patches made by the -t option. */
+#define TERRAIN_PATCH_MIN 2
+#define TERRAIN_PATCH_MAX 24
+/* Highest terrain cost, the cost digits go from '2' up to this digit. */
+#define TERRAIN_MAX_COST 9
+/* Prim's frontier list starts with this many cells and grows when full. */
+#define FRONTIER_START_SIZE 1024
+/* Rounds of the Feistel network that shuffles the walls for Kruskal. */
+#define FEISTEL_ROUNDS 4
+
+/* The directions as (row, column) steps: up, right, down, left. */
+static const int steps[4][2] = { { -1, 0 }, { 0, 1 }, { 1, 0 }, { 0, -1 } };
+
+/* xorshift64* generator, so a seed gives the same maze on every platform. */
+static uint64_t rng_state;
+
+static void rng_seed(uint64_t seed) {
+    rng_state = seed ? seed : DEFAULT_SEED;
+}
+
+/* Returns a pseudo random number in [0, bound). */
+static unsigned long rng_below(unsigned long bound) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (unsigned long)((rng_state * 0x2545F4914F6CDD1DULL) >> 33) % bound;
+}
+
+/* Returns a well mixed 64-bit hash of 'x' (splitmix64 finalizer). */
+static uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/* Returns the position of (r, c) in a grid with 'cols' columns. */
+static size_t at(int r, int c, int cols) {
+    return (size_t)r * (size_t)cols + (size_t)c;
+}
+
+/* Fills the 'rows' by 'cols' grid with floor surrounded by a border of
+ * walls. */
+static void fill_border(char *grid, int rows, int cols) {
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int border = r == 0 || c == 0 || r == rows - 1 || c == cols - 1;
+            grid[at(r, c, cols)] = border ? '#' : ' ';
+        }
+    }
+}
+
+static void generate_open(char *grid, int rows, int cols) {
+    fill_border(grid, rows, cols);
+    for (size_t i = 0; i < at(rows, 0, cols); i++) {
+        if (grid[i] == ' ' && rng_below(100) < OPEN_WALL_PERCENT) {
+            grid[i] = '#';
+        }
+    }
+}
+
+static void generate_rooms(char *grid, int rows, int cols) {
+    fill_border(grid, rows, cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (r % ROOM_SIZE == 0 || c % ROOM_SIZE == 0) {
+                grid[at(r, c, cols)] = '#';
+            }
+        }
+    }
+
+    /* One door in every wall segment between two rooms. */
+    for (int r = 0; r + 1 < rows; r += ROOM_SIZE) {
+        for (int c = 0; c + 1 < cols; c += ROOM_SIZE) {
+            int height = (r + ROOM_SIZE < rows - 1 ? ROOM_SIZE : rows - 1 - r) - 1;
+            int width = (c + ROOM_SIZE < cols - 1 ? ROOM_SIZE : cols - 1 - c) - 1;
+            if (height <= 0 || width <= 0) {
+                continue;
+            }
+            if (c + ROOM_SIZE < cols - 1) {
+                int door = r + 1 + (int)rng_below((unsigned long)height);
+                grid[at(door, c + ROOM_SIZE, cols)] = ' ';
+            }
+            if (r + ROOM_SIZE < rows - 1) {
+                int door = c + 1 + (int)rng_below((unsigned long)width);
+                grid[at(r + ROOM_SIZE, door, cols)] = ' ';
+            }
+        }
+    }
+}
+
+/* Fills the grid with walls, the perfect maze styles carve the cells and
+ * the walls between them out of it. */
+static void fill_walls(char *grid, int rows, int cols) {
+    memset(grid, '#', at(rows, 0, cols));
+}
+
+/* Returns true if (r, c) is a cell of a perfect maze: on an odd row and an
+ * odd column inside the border. */
+static int is_cell(int r, int c, int rows, int cols) {
+    return r > 0 && c > 0 && r < rows - 1 && c < cols - 1 && r % 2 == 1
+           && c % 2 == 1;
+}
+
+/* Randomized depth-first search from cell (1, 1). Instead of a stack every
+ * visited cell stores the direction back to the cell it was reached from
+ * as a digit, so the search needs no memory besides the grid. */
+static void generate_backtracker(char *grid, int rows, int cols) {
+    fill_walls(grid, rows, cols);
+    int r = 1, c = 1;
+    grid[at(r, c, cols)] = 'o';
+    for (;;) {
+        int options[4];
+        int n_options = 0;
+        for (int d = 0; d < 4; d++) {
+            int nr = r + 2 * steps[d][0], nc = c + 2 * steps[d][1];
+            if (is_cell(nr, nc, rows, cols) && grid[at(nr, nc, cols)] == '#') {
+                options[n_options++] = d;
+            }
+        }
+
+        if (n_options > 0) {
+            int d = options[rng_below((unsigned long)n_options)];
+            grid[at(r + steps[d][0], c + steps[d][1], cols)] = ' ';
+            r += 2 * steps[d][0];
+            c += 2 * steps[d][1];
+            grid[at(r, c, cols)] = (char)('0' + (d + 2) % 4);
+        } else if (grid[at(r, c, cols)] == 'o') {
+            break;
+        } else {
+            int d = grid[at(r, c, cols)] - '0';
+            r += 2 * steps[d][0];
+            c += 2 * steps[d][1];
+        }
+    }
+
+    for (size_t i = 0; i < at(rows, 0, cols); i++) {
+        if (grid[i] != '#') {
+            grid[i] = ' ';
+        }
+    }
+}
+
+/* Adds the unvisited cells next to cell (r, c) to the frontier list and
+ * marks them with 'f'. Returns 0 if successful, 1 otherwise. */
+static int add_frontier(char *grid, int rows, int cols, int r, int c,
+                        size_t **frontier, size_t *size, size_t *capacity) {
+    for (int d = 0; d < 4; d++) {
+        int nr = r + 2 * steps[d][0], nc = c + 2 * steps[d][1];
+        if (!is_cell(nr, nc, rows, cols) || grid[at(nr, nc, cols)] != '#') {
+            continue;
+        }
+        if (*size == *capacity) {
+            size_t *grown = realloc(*frontier, 2 * *capacity * sizeof(size_t));
+            if (grown == NULL) {
+                return 1;
+            }
+            *frontier = grown;
+            *capacity *= 2;
+        }
+        grid[at(nr, nc, cols)] = 'f';
+        (*frontier)[(*size)++] = at(nr, nc, cols);
+    }
+    return 0;
+}
+
+/* Randomized Prim's algorithm: a random cell of the frontier around the
+ * maze is joined to a random neighbouring cell that is already part of it.
+ * Returns 0 if successful, 1 if there was not enough memory. */
+static int generate_prim(char *grid, int rows, int cols) {
+    fill_walls(grid, rows, cols);
+    size_t capacity = FRONTIER_START_SIZE;
+    size_t size = 0;
+    size_t *frontier = malloc(capacity * sizeof(size_t));
+    if (frontier == NULL) {
+        return 1;
+    }
+
+    grid[at(1, 1, cols)] = ' ';
+    int failed = add_frontier(grid, rows, cols, 1, 1, &frontier, &size, &capacity);
+    while (!failed && size > 0) {
+        size_t pick = rng_below(size);
+        size_t cell = frontier[pick];
+        frontier[pick] = frontier[--size];
+        int r = (int)(cell / (size_t)cols), c = (int)(cell % (size_t)cols);
+
+        int options[4];
+        int n_options = 0;
+        for (int d = 0; d < 4; d++) {
+            int nr = r + 2 * steps[d][0], nc = c + 2 * steps[d][1];
+            if (is_cell(nr, nc, rows, cols) && grid[at(nr, nc, cols)] == ' ') {
+                options[n_options++] = d;
+            }
+        }
+        int d = options[rng_below((unsigned long)n_options)];
+        grid[at(r + steps[d][0], c + steps[d][1], cols)] = ' ';
+        grid[cell] = ' ';
+        failed = add_frontier(grid, rows, cols, r, c, &frontier, &size, &capacity);
+    }
+    free(frontier);
+    return failed;
+}
+
+/* Returns the root of the set of cell 'x', halving the path on the way. */
+static uint32_t find_root(uint32_t *parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/* A Feistel network on numbers of 2 * 'half' bits. It is a bijection, so
+ * going through all numbers below 2^(2 * half) visits every number once in
+ * a random looking order, without storing a shuffled array. */
+static uint64_t feistel(uint64_t x, int half, uint64_t key) {
+    uint64_t mask = ((uint64_t)1 << half) - 1;
+    uint64_t left = x >> half, right = x & mask;
+    for (int round = 0; round < FEISTEL_ROUNDS; round++) {
+        uint64_t next = left ^ (mix(right ^ (key + (uint64_t)round)) & mask);
+        left = right;
+        right = next;
+    }
+    return left << half | right;
+}
+
+/* Randomized Kruskal's algorithm: every wall between two cells is visited
+ * in a random order and removed if the cells on both sides are not yet
+ * connected. The sets of connected cells are kept in a union-find with
+ * 32-bit parents. Returns 0 if successful, 1 otherwise. */
+static int generate_kruskal(char *grid, int rows, int cols) {
+    fill_walls(grid, rows, cols);
+    uint64_t height = (uint64_t)(rows - 1) / 2, width = (uint64_t)(cols - 1) / 2;
+    if (height * width > UINT32_MAX) {
+        return 1;
+    }
+    uint32_t *parent = malloc(height * width * sizeof(uint32_t));
+    unsigned char *rank = calloc(height * width, 1);
+    if (parent == NULL || rank == NULL) {
+        free(parent);
+        free(rank);
+        return 1;
+    }
+    for (uint32_t i = 0; i < height * width; i++) {
+        parent[i] = i;
+        grid[at(2 * (int)(i / width) + 1, 2 * (int)(i % width) + 1, cols)] = ' ';
+    }
+
+    /* Walls 0 .. horizontal - 1 lie between two cells next to each other,
+    the others between two cells above each other. */
+    uint64_t horizontal = height * (width - 1);
+    uint64_t n_walls = horizontal + (height - 1) * width;
+    int half = 1;
+    while (((uint64_t)1 << (2 * half)) < n_walls) {
+        half++;
+    }
+    uint64_t key = rng_below(UINT32_MAX);
+
+    for (uint64_t x = 0; x < (uint64_t)1 << (2 * half); x++) {
+        uint64_t wall = feistel(x, half, key);
+        if (wall >= n_walls) {
+            continue;
+        }
+        uint64_t a, b;
+        if (wall < horizontal) {
+            a = wall / (width - 1) * width + wall % (width - 1);
+            b = a + 1;
+        } else {
+            a = wall - horizontal;
+            b = a + width;
+        }
+
+        uint32_t root_a = find_root(parent, (uint32_t)a);
+        uint32_t root_b = find_root(parent, (uint32_t)b);
+        if (root_a == root_b) {
+            continue;
+        }
+        if (rank[root_a] < rank[root_b]) {
+            parent[root_a] = root_b;
+        } else {
+            parent[root_b] = root_a;
+            if (rank[root_a] == rank[root_b]) {
+                rank[root_a]++;
+            }
+        }
+        int r = 2 * (int)(a / width) + 1, c = 2 * (int)(a % width) + 1;
+        grid[at(r + (wall >= horizontal), c + (wall < horizontal), cols)] = ' ';
+    }
+    free(parent);
+    free(rank);
+    return 0;
+}
+
+/* Knocks down 'percent' percent of the walls that separate two cells of a
+ * perfect maze, which adds loops. */
+static void add_loops(char *grid, int rows, int cols, int percent) {
+    for (int r = 1; r < rows - 1; r++) {
+        for (int c = 1 + r % 2; c < cols - 1; c += 2) {
+            int between_rows = r % 2 == 0 && r + 1 < rows - 1;
+            int between_cols = r % 2 == 1 && c + 1 < cols - 1;
+            if ((between_rows || between_cols) && grid[at(r, c, cols)] == '#'
+                && rng_below(100) < (unsigned long)percent) {
+                grid[at(r, c, cols)] = ' ';
+            }
+        }
+    }
+}
+
+/* Clears random rooms until the summed area of the rooms is about
+ * 'percent' percent of the inside of the maze. */
+static void add_rooms(char *grid, int rows, int cols, int percent) {
+    uint64_t target = (uint64_t)(rows - 2) * (uint64_t)(cols - 2)
+                      * (uint64_t)percent / 100;
+    uint64_t cleared = 0;
+    int span = CLEARED_ROOM_MAX - CLEARED_ROOM_MIN + 1;
+    while (cleared < target) {
+        int height = CLEARED_ROOM_MIN + (int)rng_below((unsigned long)span);
+        int width = CLEARED_ROOM_MIN + (int)rng_below((unsigned long)span);
+        height = height < rows - 2 ? height : rows - 2;
+        width = width < cols - 2 ? width : cols - 2;
+        int top = 1 + (int)rng_below((unsigned long)(rows - 1 - height));
+        int left = 1 + (int)rng_below((unsigned long)(cols - 1 - width));
+        for (int r = top; r < top + height; r++) {
+            memset(grid + at(r, left, cols), ' ', (size_t)width);
+        }
+        cleared += (uint64_t)height * (uint64_t)width;
+    }
+}
+
+/* Covers the floor with random patches of terrain until the summed area of
+ * the patches is about 'percent' percent of the inside of the maze. Walls
+ * stay walls. */
+static void add_terrain(char *grid, int rows, int cols, int percent) {
+    uint64_t target = (uint64_t)(rows - 2) * (uint64_t)(cols - 2)
+                      * (uint64_t)percent / 100;
+    uint64_t covered = 0;
+    int span = TERRAIN_PATCH_MAX - TERRAIN_PATCH_MIN + 1;
+    while (covered < target) {
+        int height = TERRAIN_PATCH_MIN + (int)rng_below((unsigned long)span);
+        int width = TERRAIN_PATCH_MIN + (int)rng_below((unsigned long)span);
+        height = height < rows - 2 ? height : rows - 2;
+        width = width < cols - 2 ? width : cols - 2;
+        int top = 1 + (int)rng_below((unsigned long)(rows - 1 - height));
+        int left = 1 + (int)rng_below((unsigned long)(cols - 1 - width));
+        char cost = (char)('2' + rng_below(TERRAIN_MAX_COST - 1));
+        for (int r = top; r < top + height; r++) {
+            for (int c = left; c < left + width; c++) {
+                if (grid[at(r, c, cols)] != '#') {
+                    grid[at(r, c, cols)] = cost;
+                }
+            }
+        }
+        covered += (uint64_t)height * (uint64_t)width;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int loop_percent = 0;
+    int room_percent = 0;
+    int terrain_percent = 0;
+    int option;
+    while ((option = getopt(argc, argv, "l:r:t:")) != -1) {
+        if (option == 'l') {
+            loop_percent = atoi(optarg);
+        } else if (option == 'r') {
+            room_percent = atoi(optarg);
+        } else if (option == 't') {
+            terrain_percent = atoi(optarg);
+        } else {
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (argc - optind < 2 || argc - optind > 3 || loop_percent < 0
+        || loop_percent > 100 || room_percent < 0 || room_percent > 100
+        || terrain_percent < 0 || terrain_percent > 100) {
+        fprintf(stderr, "Usage: %s [-l loop_percent] [-r room_percent] "
+                "[-t terrain_percent] size|rowsxcols open|rooms|backtracker|prim|kruskal [seed]\n",
+                argv[0]);
+        return 1;
+    }
+    const char *style = argv[optind + 1];
+
+    char *end;
+    int rows = (int)strtol(argv[optind], &end, 10);
+    int cols = *end == 'x' ? (int)strtol(end + 1, &end, 10) : rows;
+    if (rows < 5 || cols < 5 || *end != '\0') {
+        fprintf(stderr, "The size should be at least 5 by 5\n");
+        return 1;
+    }
+    rng_seed(argc - optind == 3 ? strtoull(argv[optind + 2], NULL, 10)
+                                : DEFAULT_SEED);
+
+    char *grid = malloc(at(rows, 0, cols));
+    if (grid == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    int failed = 0;
+    if (strcmp(style, "open") == 0) {
+        generate_open(grid, rows, cols);
+    } else if (strcmp(style, "rooms") == 0) {
+        generate_rooms(grid, rows, cols);
+    } else if (strcmp(style, "backtracker") == 0) {
+        generate_backtracker(grid, rows, cols);
+    } else if (strcmp(style, "prim") == 0) {
+        failed = generate_prim(grid, rows, cols);
+    } else if (strcmp(style, "kruskal") == 0) {
+        failed = generate_kruskal(grid, rows, cols);
+    } else {
+        fprintf(stderr, "Unknown maze style %s\n", style);
+        free(grid);
+        return 1;
+    }
+    if (failed) {
+        fprintf(stderr, "Out of memory\n");
+        free(grid);
+        return 1;
+    }
+    add_loops(grid, rows, cols, loop_percent);
+    add_rooms(grid, rows, cols, room_percent);
+    add_terrain(grid, rows, cols, terrain_percent);
+
+    /* The start and destination cells are always floor. With an even size
+    the destination is not a cell of a perfect maze, so it is connected to
+    the nearest cell. */
+    int r = rows - 2, c = cols - 2;
+    grid[at(r, c, cols)] = ' ';
+    if (r % 2 == 0) {
+        grid[at(--r, c, cols)] = ' ';
+    }
+    if (c % 2 == 0) {
+        grid[at(r, --c, cols)] = ' ';
+    }
+    grid[at(1, 1, cols)] = 'S';
+    grid[at(rows - 2, cols - 2, cols)] = 'D';
+
+    for (int row = 0; row < rows; row++) {
+        fwrite(grid + at(row, 0, cols), 1, (size_t)cols, stdout);
+        putchar('\n');
+    }
+    free(grid);
+    return 0;
+}
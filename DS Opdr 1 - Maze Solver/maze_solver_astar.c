@@ -0,0 +1,148 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bitset.h"
+#include "heap.h"
+#include "maze.h"
+#include "output.h"
+#include "pred.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+/* Begin grote van de heap, de heap groeit zelf als hij vol is. */
+#define HEAP_START_SIZE 1024
+
+/*Returned de Manhattan afstand tussen (r, c) en (dest_r, dest_c), dit
+onderschat nooit de echte afstand in een doolhof met vier richtingen.*/
+static inline int manhattan(int r, int c, int dest_r, int dest_c) {
+    return abs(r - dest_r) + abs(c - dest_c);
+}
+
+/*Implementeert het A* algoritme met de Manhattan afstand als heuristiek, deze
+returned hierbij de lengte van kortste pad.
+
+struct maze *m = een struct maze pointer naar m
+long *expansions = het aantal cellen dat uitgebreid is
+
+side effects: de heap wordt ge-cleanupd, de uitgebreide cellen worden als
+VISITED gemarkeerd
+*/
+int astar_solve(struct maze *m, long *expansions) {
+    int dest_r, dest_c;
+    maze_destination(m, &dest_r, &dest_c);
+    int64_t dest_index = maze_index(m, dest_r, dest_c);
+
+    struct heap *heap = heap_init(HEAP_START_SIZE);
+        if (heap == NULL) {
+            return ERROR;
+        }
+
+    struct pred *pred = pred_init((size_t)maze_cells(m));
+        if (pred == NULL) {
+            heap_cleanup(heap);
+            return ERROR;
+        }
+
+    const uint64_t *walls = maze_walls(m);
+    uint64_t *closed = maze_visited(m);
+    *expansions = 0;
+
+    /* De waarde in de heap is de index van de cel maal N_MOVES plus de
+    zet waarmee de cel bereikt is, de zet wordt pas opgeslagen als de cel
+    uit de heap komt en zijn kortste pad dus vast ligt. */
+    int r_start, c_start = 0;
+    maze_start(m, &r_start, &c_start);
+    int64_t start_index = maze_index(m, r_start, c_start);
+    int h_start = manhattan(r_start, c_start, dest_r, dest_c);
+    if (heap_push(heap, heap_key(h_start, 0), start_index * N_MOVES) != 0) {
+        pred_cleanup(pred);
+        heap_cleanup(heap);
+        return ERROR;
+    }
+
+    while (heap_empty(heap) == 0) {
+        uint64_t key;
+        int64_t entry = heap_pop(heap, &key);
+        int64_t current_index = entry / N_MOVES;
+        if (bitset_get(closed, (size_t)current_index)) {
+            continue;
+        }
+        bitset_set(closed, (size_t)current_index);
+        if (current_index != start_index) {
+            pred_set(pred, (size_t)current_index, (int)(entry % N_MOVES));
+        }
+        (*expansions)++;
+
+        if (current_index == dest_index) {
+            int lengte = pred_backtrack(m, pred);
+            pred_cleanup(pred);
+            heap_cleanup(heap);
+            return lengte;
+        }
+
+        int current_r = maze_row(m, current_index);
+        int current_c = maze_col(m, current_index);
+        int g = (int)(UINT32_MAX - (uint32_t)key);
+        for (int i = 0; i < N_MOVES; i++) {
+            int r_new = current_r + m_offsets[i][0];
+            int c_new = current_c + m_offsets[i][1];
+            size_t new_index = (size_t)maze_index(m, r_new, c_new);
+
+            if (maze_valid_move(m, r_new, c_new) && !bitset_get(walls, new_index)
+                && !bitset_get(closed, new_index)) {
+                int f = g + 1 + manhattan(r_new, c_new, dest_r, dest_c);
+                if (heap_push(heap, heap_key(f, g + 1),
+                              (int64_t)new_index * N_MOVES + i) != 0) {
+                    pred_cleanup(pred);
+                    heap_cleanup(heap);
+                    return ERROR;
+                }
+            }
+        }
+    }
+    pred_cleanup(pred);
+    heap_cleanup(heap);
+    return NOT_FOUND;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output;
+    if (output_options(&output, argc, argv) != 0) {
+        printf("Usage: %s " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    long expansions = 0;
+    double start = timer_ms();
+    int path_length = astar_solve(m, &expansions);
+    fprintf(stderr, "astar expanded %ld cells in %.3f ms\n", expansions,
+            timer_ms() - start);
+    if (path_length == ERROR) {
+        printf("astar failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("astar found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
@@ -0,0 +1,352 @@
+// Needed for opendir(), sysconf(), getopt() and clock_gettime()
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bfs.h"
+#include "maze.h"
+#include "output.h"
+#include "pred.h"
+#include "queue.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+#define READ_ERROR -3
+/* Begin grote van de queue, de queue groeit zelf als hij vol is. */
+#define QUEUE_START_SIZE 1024
+/* Begin grote van de lijst met mazes, de lijst groeit zelf. */
+#define TASKS_START_SIZE 64
+#define MAX_THREADS 256
+/* Uit een map worden alleen de bestanden met deze extensie gelost, zodat de
+referentie bestanden naast de mazes overgeslagen worden. */
+#define MAZE_EXTENSION ".txt"
+
+/* Een maze uit de lijst en de uitkomst van de bfs. */
+struct task {
+    char *filename;
+    int length;
+    size_t visited;
+};
+
+/* De lijst met mazes die de threads samen aflopen. 'next' is de eerstvolgende
+maze die nog niet geclaimd is, een thread claimt een maze door 'next'
+atomair op te hogen. */
+struct batch {
+    struct task *tasks;
+    size_t n_tasks;
+    size_t capacity;
+    size_t next;
+    const char *ppm_dir;
+    int ppm_size;
+};
+
+/* Elke thread houdt zijn queue en voorgangers over alle mazes heen, zodat
+deze niet voor elke maze opnieuw gealloceerd worden en alleen groeien als
+een maze groter is dan alle vorige. */
+struct worker {
+    struct batch *b;
+    struct queue *queue;
+    struct pred *pred;
+    size_t pred_cells;
+};
+
+/*Returned een integer die aangeeft of 'filename' aan de lijst toegevoegd is,
+0 indien wel, 1 indien niet
+
+struct batch *b : de lijst met mazes
+const char *filename : het bestand, wordt gekopieerd*/
+static int batch_add(struct batch *b, const char *filename) {
+    if (b->n_tasks == b->capacity) {
+        size_t capacity = b->capacity ? 2 * b->capacity : TASKS_START_SIZE;
+        struct task *grown = realloc(b->tasks, capacity * sizeof(struct task));
+        if (grown == NULL) {
+            return 1;
+        }
+        b->tasks = grown;
+        b->capacity = capacity;
+    }
+    struct task *t = &b->tasks[b->n_tasks];
+    t->filename = malloc(strlen(filename) + 1);
+    if (t->filename == NULL) {
+        return 1;
+    }
+    strcpy(t->filename, filename);
+    t->length = ERROR;
+    t->visited = 0;
+    b->n_tasks++;
+    return 0;
+}
+
+/*Returned het verschil tussen de bestandsnamen van twee taken voor qsort()*/
+static int task_compare(const void *a, const void *b) {
+    return strcmp(((const struct task *)a)->filename,
+                  ((const struct task *)b)->filename);
+}
+
+/*Returned een integer die aangeeft of de mazes van 'arg' toegevoegd zijn, 0
+indien wel, 1 indien niet
+
+struct batch *b : de lijst met mazes
+const char *arg : een bestand, een map of "-" voor stdin
+
+Side effect: van een map worden de bestanden die op MAZE_EXTENSION eindigen
+op naam gesorteerd toegevoegd. Een tweede "-" wordt geweigerd, twee workers
+kunnen stdin niet tegelijk lezen en de tweede maze zou toch leeg zijn.*/
+static int batch_collect(struct batch *b, const char *arg) {
+    if (strcmp(arg, "-") == 0) {
+        for (size_t i = 0; i < b->n_tasks; i++) {
+            if (strcmp(b->tasks[i].filename, "-") == 0) {
+                return 1;
+            }
+        }
+        return batch_add(b, arg);
+    }
+
+    struct stat st;
+    if (stat(arg, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        /* Een bestand dat niet bestaat geeft later een leesfout. */
+        return batch_add(b, arg);
+    }
+
+    DIR *dir = opendir(arg);
+    if (dir == NULL) {
+        return 1;
+    }
+    size_t first = b->n_tasks;
+    size_t ext_len = strlen(MAZE_EXTENSION);
+    int failed = 0;
+    struct dirent *entry;
+    while (!failed && (entry = readdir(dir)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        if (len <= ext_len
+            || strcmp(entry->d_name + len - ext_len, MAZE_EXTENSION) != 0) {
+            continue;
+        }
+        char *path = malloc(strlen(arg) + len + 2);
+        if (path == NULL) {
+            failed = 1;
+            break;
+        }
+        sprintf(path, "%s/%s", arg, entry->d_name);
+        if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+            failed = batch_add(b, path);
+        }
+        free(path);
+    }
+    closedir(dir);
+    qsort(b->tasks + first, b->n_tasks - first, sizeof(struct task), task_compare);
+    return failed;
+}
+
+/*struct batch *b : de lijst met mazes
+
+Side effect: freed de lijst en de bestandsnamen*/
+static void batch_cleanup(struct batch *b) {
+    for (size_t i = 0; i < b->n_tasks; i++) {
+        free(b->tasks[i].filename);
+    }
+    free(b->tasks);
+}
+
+/*Implementeert bfs met bfs_search() uit bfs.c en de queue en de voorgangers
+van 'w', deze returned hierbij de lengte van kortste pad.
+
+struct worker *w : de thread met de buffers
+struct maze *m : het doolhof
+
+side effects: de voorgangers groeien als het doolhof meer cellen heeft, de
+bezochte cellen en het pad worden gemarkeerd in m
+*/
+static int batch_bfs(struct worker *w, struct maze *m) {
+    size_t cells = (size_t)maze_cells(m);
+    if (cells > w->pred_cells) {
+        pred_cleanup(w->pred);
+        w->pred = pred_init(cells);
+        w->pred_cells = w->pred ? cells : 0;
+        if (w->pred == NULL) {
+            return ERROR;
+        }
+    }
+    return bfs_search(m, w->queue, w->pred);
+}
+
+/*Returned een integer die aangeeft of de ppm van 't' geschreven is, 0 indien
+wel, 1 indien niet
+
+const struct maze *m : het opgeloste doolhof
+const struct task *t : de taak, de ppm krijgt de naam van het bestand zonder
+map en extensie
+const char *ppm_dir : de map voor de ppm bestanden
+int ppm_size : de maximale grote van de ppm, 0 voor een pixel per cel*/
+static int write_ppm(const struct maze *m, const struct task *t,
+                     const char *ppm_dir, int ppm_size) {
+    const char *name = strcmp(t->filename, "-") == 0 ? "stdin" : t->filename;
+    const char *slash = strrchr(name, '/');
+    if (slash != NULL) {
+        name = slash + 1;
+    }
+    size_t len = strlen(name);
+    const char *dot = strrchr(name, '.');
+    if (dot != NULL && dot != name) {
+        len = (size_t)(dot - name);
+    }
+
+    char *path = malloc(strlen(ppm_dir) + len + sizeof("/.ppm"));
+    if (path == NULL) {
+        return 1;
+    }
+    sprintf(path, "%s/%.*s.ppm", ppm_dir, (int)len, name);
+    int failed = maze_output_ppm_scaled(m, path, ppm_size);
+    free(path);
+    return failed;
+}
+
+/*Returned NULL, de thread functie van de workers
+
+void *arg : de struct worker van de thread
+
+Side effect: lost mazes op totdat de lijst op is*/
+static void *worker_run(void *arg) {
+    struct worker *w = arg;
+    struct batch *b = w->b;
+    for (;;) {
+        size_t i = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED);
+        if (i >= b->n_tasks) {
+            return NULL;
+        }
+        struct task *t = &b->tasks[i];
+        struct maze *m = strcmp(t->filename, "-") == 0
+                         ? maze_read() : maze_read_file(t->filename);
+        if (m == NULL) {
+            t->length = READ_ERROR;
+            continue;
+        }
+        t->length = batch_bfs(w, m);
+        t->visited = maze_count_visited(m);
+        if (t->length >= 0 && b->ppm_dir != NULL
+            && write_ppm(m, t, b->ppm_dir, b->ppm_size) != 0) {
+            t->length = ERROR;
+        }
+        maze_cleanup(m);
+    }
+}
+
+/*Returned een integer die aangeeft of alle mazes een pad hebben, 0 indien
+wel, 1 indien niet
+
+const struct batch *b : de opgeloste lijst
+
+Side effect: print de uitkomst van elke maze op volgorde van de lijst*/
+static int print_results(const struct batch *b) {
+    int failed = 0;
+    for (size_t i = 0; i < b->n_tasks; i++) {
+        const struct task *t = &b->tasks[i];
+        printf("%s: ", t->filename);
+        if (t->length >= 0) {
+            printf("bfs found a path of length: %d\n", t->length);
+        } else if (t->length == NOT_FOUND) {
+            printf("no path found from start to destination\n");
+        } else if (t->length == READ_ERROR) {
+            printf("Error reading maze\n");
+        } else {
+            printf("bfs failed\n");
+        }
+        failed |= t->length < 0;
+    }
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    /* -j zet het aantal threads, -p schrijft een ppm van elke opgeloste maze
+    in de gegeven map en -r verkleint die ppm's net als bij de solvers. */
+    long n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *ppm_dir = NULL;
+    int ppm_size = 0;
+    int option;
+    while ((option = getopt(argc, argv, "j:p:r:")) != -1) {
+        if (option == 'j') {
+            n_threads = strtol(optarg, NULL, 10);
+        } else if (option == 'p') {
+            ppm_dir = optarg;
+        } else if (option == 'r' && (ppm_size = output_size(optarg)) > 0) {
+            continue;
+        } else {
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind >= argc || n_threads < 1 || n_threads > MAX_THREADS) {
+        printf("Usage: %s [-j threads (1 - %d)] [-p ppm_dir] [-r size] "
+               "file|dir|- ...\n", argv[0], MAX_THREADS);
+        return 1;
+    }
+
+    struct batch b = { NULL, 0, 0, 0, ppm_dir, ppm_size };
+    for (int i = optind; i < argc; i++) {
+        if (batch_collect(&b, argv[i]) != 0) {
+            printf("Error reading %s\n", argv[i]);
+            batch_cleanup(&b);
+            return 1;
+        }
+    }
+    if ((size_t)n_threads > b.n_tasks) {
+        n_threads = b.n_tasks > 0 ? (long)b.n_tasks : 1;
+    }
+
+    /* De aanroepende thread is worker 0, threads die niet gestart kunnen
+    worden vallen af en de overige threads nemen hun mazes over. */
+    struct worker workers[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    int failed = 0;
+    for (long t = 0; t < n_threads; t++) {
+        workers[t].b = &b;
+        workers[t].queue = queue_init(QUEUE_START_SIZE);
+        workers[t].pred = NULL;
+        workers[t].pred_cells = 0;
+        failed |= workers[t].queue == NULL;
+    }
+
+    double start = timer_ms();
+    long started = 1;
+    if (!failed) {
+        for (; started < n_threads; started++) {
+            if (pthread_create(&threads[started], NULL, worker_run,
+                               &workers[started]) != 0) {
+                break;
+            }
+        }
+        worker_run(&workers[0]);
+        for (long t = 1; t < started; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    double elapsed = timer_ms() - start;
+
+    size_t visited = 0;
+    for (size_t i = 0; i < b.n_tasks; i++) {
+        visited += b.tasks[i].visited;
+    }
+    for (long t = 0; t < n_threads; t++) {
+        queue_cleanup(workers[t].queue);
+        pred_cleanup(workers[t].pred);
+    }
+    if (failed) {
+        printf("batch failed\n");
+        batch_cleanup(&b);
+        return 1;
+    }
+    fprintf(stderr, "batch solved %zu mazes with %ld threads, visited %zu "
+            "cells in %.3f ms\n", b.n_tasks, started, visited, elapsed);
+
+    failed = print_results(&b);
+    batch_cleanup(&b);
+    return failed;
+}
@@ -1,139 +1,200 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
 
+#include "bfs.h"
+#include "bitset.h"
 #include "maze.h"
+#include "output.h"
+#include "pred.h"
 #include "queue.h"
+#include "timer.h"
 
 #define NOT_FOUND -1
 #define ERROR -2
-#define STACK_SIZE 4000
-
-/*Returned de lengte van het pad door het doolhof
-
-Struct maze *m = de struct maze pointer m
-int **visitarray = de 2d array die de indexen van de voorgaande
-stappen in het doolhof bevat
-int dest_r = de rij van het doelwit
-int dest_c = de kolom van het doelwit
-
-Side effect: De visist array wordt gevuld met indexen van punten 
-in het doolhof*/
-int backtrack(struct maze *m, int **visitarray, int dest_r, int dest_c) {
-    int lengte = 0;
-    int array_index = visitarray[dest_r][dest_c];
-
-    maze_set(m, dest_r, dest_c, 'x');
-    lengte++;
+/* Begin grote van de queue, de queue groeit zelf als hij vol is. */
+#define QUEUE_START_SIZE 1024
 
-    while (!maze_at_start(m, maze_row(m, array_index), maze_col(m, array_index))) {
-        int r = maze_row(m, array_index);
-        int c = maze_col(m, array_index);
+/*Implementeert het bfs_solve algoritme met bfs_search() uit bfs.c, deze
+returned hierbij de lengte van kortste pad.
 
-        maze_set(m, r, c, 'x');
-
-        array_index = visitarray[r][c];
-        lengte++;
-    }
-    return lengte;
-}
-
-/* int **visitarray = de 2d array die de indexen van de voorgaande stappen in 
-het doolhof bevat
-int total_size = de lengte of breedte van het doolhof
+struct maze *m = een struct maze pointer naar m
 
-Side effect: Freed het doolhof
+side effects: de queue en de voorgangers worden ge-cleanupd
 */
-void free_visitarray(int **visitarray, int total_size) {
-    for (int i = 0; i < total_size; i++) {
-        free(visitarray[i]);
+int bfs_solve(struct maze *m) {
+    struct queue *queue = queue_init(QUEUE_START_SIZE);
+    struct pred *pred = pred_init((size_t)maze_cells(m));
+    int length = ERROR;
+    if (queue != NULL && pred != NULL) {
+        length = bfs_search(m, queue, pred);
     }
-    free(visitarray);
+    pred_cleanup(pred);
+    queue_cleanup(queue);
+    return length;
 }
 
-/* Returned de gealloceerde en geinitialliseerde int** naar de 
-visitarray op de heap of NULL als dat niet is gelukt.
-
-int r: de lengte van het doolhof
-int c: de breedte van het doolhof*/
-int **create_visitarray(int r, int c) {
-    size_t rows = (size_t)r;
-    size_t cols = (size_t)c;
-
-    int **visitarray = (int**)malloc(rows * (sizeof(int*)));
-    if (visitarray == NULL) {
-        return NULL;
+/* De toestand van een van de twee zoektochten van bibfs_solve(). */
+struct bfs_side {
+    struct queue *queue;
+    struct pred *pred;
+    uint64_t *visited;
+};
+
+/*Returned een integer die aangeeft of de zoektocht voor 'side' klaar gezet is, 0 indien wel, 1 indien niet
+
+struct bfs_side *side : de zoektocht
+const struct maze *m : het doolhof
+int64_t start_index : de cel waar de zoektocht begint
+uint64_t *visited : de bitset voor de bezochte cellen, of NULL om een nieuwe
+te alloceren*/
+static int side_init(struct bfs_side *side, const struct maze *m,
+                     int64_t start_index, uint64_t *visited) {
+    side->queue = queue_init(QUEUE_START_SIZE);
+    side->pred = pred_init((size_t)maze_cells(m));
+    side->visited = visited ? visited : calloc(maze_words(m), sizeof(uint64_t));
+    if (!side->queue || !side->pred || !side->visited
+        || queue_push(side->queue, start_index) != 0) {
+        return 1;
     }
+    bitset_set(side->visited, (size_t)start_index);
+    return 0;
+}
 
-    for (int i = 0; i < r; i++) {
-    visitarray[i] = (int*)malloc(cols * sizeof(int));
-        if (visitarray[i] == NULL) {
-            free(visitarray);
-            return NULL;
+/*Returned 1 als de twee zoektochten elkaar ontmoet hebben, 0 indien niet en
+ERROR als er iets mis ging.
+
+struct maze *m : het doolhof
+struct bfs_side *side : de zoektocht die een level verder gaat
+const struct bfs_side *other : de andere zoektocht
+int64_t *meet_from : de cel van 'side' waar de zoektochten elkaar raken
+int64_t *meet_to : de cel van 'other' naast 'meet_from'
+
+Side effect: breidt alle cellen van het huidige level van 'side' uit. Een
+ontmoeting die tijdens dit level gevonden wordt is altijd een kortste pad,
+omdat elke ontmoeting met een eerder level van 'other' al eerder gezien zou
+zijn.*/
+static int side_expand(struct maze *m, struct bfs_side *side,
+                       const struct bfs_side *other, int64_t *meet_from,
+                       int64_t *meet_to) {
+    const uint64_t *walls = maze_walls(m);
+    const int64_t *steps = maze_steps(m);
+    size_t level_size = queue_size(side->queue);
+
+    for (size_t n = 0; n < level_size; n++) {
+        int64_t current_index = queue_pop(side->queue);
+
+        for (int i = 0; i < N_MOVES; i++) {
+            size_t new_index = (size_t)maze_step(m, steps, current_index, i);
+
+            if (bitset_get(walls, new_index)) {
+                continue;
+            }
+            if (bitset_get(other->visited, new_index)) {
+                *meet_from = current_index;
+                *meet_to = (int64_t)new_index;
+                return 1;
+            }
+            if (!bitset_get(side->visited, new_index)) {
+                if (queue_push(side->queue, (int64_t)new_index) != 0) {
+                    return ERROR;
+                }
+                pred_set(side->pred, new_index, i);
+                bitset_set(side->visited, new_index);
+            }
         }
     }
-    return visitarray;
+    return 0;
 }
 
-/*Implementeert het bfs_solve algoritme, deze returned hierbij
-de lengte van kortste pad.
+/*Implementeert bfs vanaf de start en de bestemming tegelijk, deze returned
+hierbij de lengte van kortste pad. Steeds gaat de zoektocht met het kleinste
+frontier een level verder, totdat de twee elkaar raken. Daarna worden de
+twee ketens van voorgangers aan elkaar geplakt tot een pad.
 
 struct maze *m = een struct maze pointer naar m
 
-side effects: de queue wordt ge-cleanupd
+side effects: de queues worden ge-cleanupd, de cellen van beide zoektochten
+worden als VISITED gemarkeerd
 */
-int bfs_solve(struct maze *m) {
-    int total_size = 0;
-    int dest_r, dest_c;
-    maze_destination(m, &dest_r, &dest_c);
-    int dest_index = maze_index(m, dest_r, dest_c);
-
-    struct queue *queue = queue_init(STACK_SIZE);
-        if (queue == NULL) {
-            return ERROR;
-        }
+int bibfs_solve(struct maze *m) {
+    int r, c;
+    maze_start(m, &r, &c);
+    int64_t start_index = maze_index(m, r, c);
+    maze_destination(m, &r, &c);
+    int64_t dest_index = maze_index(m, r, c);
+    if (start_index == dest_index) {
+        return 0;
+    }
 
-    total_size = maze_size(m);
-    int **visitarray = create_visitarray(total_size, total_size);
-        if (visitarray == NULL) {
-            return ERROR; 
+    struct bfs_side forward, backward;
+    int failed = side_init(&forward, m, start_index, maze_visited(m));
+    failed |= side_init(&backward, m, dest_index, NULL);
+
+    int length = failed ? ERROR : NOT_FOUND;
+    int64_t meet_from = 0, meet_to = 0;
+    while (length == NOT_FOUND && queue_empty(forward.queue) == 0
+           && queue_empty(backward.queue) == 0) {
+        int met;
+        if (queue_size(forward.queue) <= queue_size(backward.queue)) {
+            met = side_expand(m, &forward, &backward, &meet_from, &meet_to);
+        } else {
+            met = side_expand(m, &backward, &forward, &meet_to, &meet_from);
         }
 
-    int r_start, c_start = 0;
-    maze_start(m, &r_start, &c_start);
-    queue_push(queue, maze_index(m, r_start, c_start));
-
-    while (queue_empty(queue) == 0) {
-        int current_index = queue_pop(queue);
-        int current_r = maze_row(m, current_index);
-        int current_c = maze_col(m, current_index);
-
-        if (current_index == dest_index) {
-            int lengte = backtrack(m, visitarray, dest_r, dest_c);
-            free_visitarray(visitarray, total_size);
-            queue_cleanup(queue);
-            return lengte;
+        if (met == ERROR) {
+            length = ERROR;
+        } else if (met) {
+            /* meet_from ligt aan de kant van de start, meet_to aan de kant
+            van de bestemming. De achterwaartse keten wijst naar de
+            bestemming, dus loopt het pad van meet_to naar dest_index. */
+            length = pred_mark_path(m, forward.pred, meet_from, start_index);
+            length += pred_mark_path(m, backward.pred, meet_to, dest_index);
+            maze_set(m, r, c, PATH);
+            length++;
         }
+    }
 
-        for(int i = 0; i < 4; i ++) {
-            int r_new = current_r + m_offsets[i][0];
-            int c_new = current_c + m_offsets[i][1];
-
-            maze_set(m, current_r, current_c, VISITED);
-
-            if (maze_get(m, r_new, c_new) != WALL && maze_get(m, r_new, c_new) != VISITED && maze_valid_move(m, r_new, c_new)) {
-                queue_push(queue, maze_index(m, r_new, c_new));
-                visitarray[r_new][c_new] = current_index;
-                maze_set(m, r_new, c_new, TO_VISIT);
-            }
+    if (forward.visited && backward.visited) {
+        for (size_t w = 0; w < maze_words(m); w++) {
+            forward.visited[w] |= backward.visited[w];
         }
     }
-    free_visitarray(visitarray, total_size);
-    queue_cleanup(queue);
-    return NOT_FOUND; 
+    queue_cleanup(forward.queue);
+    queue_cleanup(backward.queue);
+    pred_cleanup(forward.pred);
+    pred_cleanup(backward.pred);
+    free(backward.visited);
+    return length;
 }
 
-int main(void) {
+int main(int argc, char *argv[]) {
+    /* -b zoekt vanaf de start en de bestemming tegelijk, -c kijkt eerst met
+    de componenten of er wel een pad is. */
+    bool bidirectional = false;
+    bool check_components = false;
+    struct output output = { true, 0 };
+    int option;
+    while ((option = getopt(argc, argv, "bc" OUTPUT_OPTIONS)) != -1) {
+        if (option == 'b') {
+            bidirectional = true;
+        } else if (option == 'c') {
+            check_components = true;
+        } else if (!output_option(&output, option, optarg)) {
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc) {
+        printf("Usage: %s [-b] [-c] " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
     /* read maze */
     struct maze *m = maze_read();
     if (!m) {
@@ -142,7 +203,16 @@ int main(void) {
     }
 
     /* solve maze */
-    int path_length = bfs_solve(m);
+    int path_length = check_components ? output_precheck(m, "bfs") : 1;
+    double start = timer_ms();
+    if (path_length == 1) {
+        path_length = bidirectional ? bibfs_solve(m) : bfs_solve(m);
+    } else {
+        path_length = path_length == 0 ? NOT_FOUND : ERROR;
+    }
+    double elapsed = timer_ms() - start;
+    fprintf(stderr, "bfs visited %zu cells in %.3f ms\n", maze_count_visited(m),
+            elapsed);
     if (path_length == ERROR) {
         printf("bfs failed\n");
         maze_cleanup(m);
@@ -155,8 +225,7 @@ int main(void) {
     printf("bfs found a path of length: %d\n", path_length);
 
     /* print maze */
-    maze_print(m, false);
-    maze_output_ppm(m, "out.ppm");
+    output_maze(m, &output);
     maze_cleanup(m);
     return 0;
 }
@@ -0,0 +1,269 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bitset.h"
+#include "maze.h"
+#include "output.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+
+/* Bit-parallel bfs. Het frontier is een bitset met dezelfde indeling als de
+muren van het doolhof (zie maze_pitch()), zodat een heel woord van 64 cellen
+in een keer een stap naar links, rechts, boven of onder kan doen met shifts en
+ANDs. Alleen de woorden waar het frontier cellen in heeft worden bijgehouden in
+een lijst, zodat een level evenveel kost als het aantal actieve woorden en niet
+als het hele doolhof.
+
+Per cel wordt het level waarop hij bereikt is modulo 3 opgeslagen in twee
+bitsets (laag en hoog bit). Buren in een bfs verschillen hoogstens een level,
+dus modulo 3 is genoeg om bij het terugzoeken het vorige level te herkennen. */
+struct bitbfs {
+    size_t words;
+    size_t pitch_words;
+    uint64_t *avail;
+    uint64_t *frontier;
+    uint64_t *next;
+    uint64_t *level_lo;
+    uint64_t *level_hi;
+    size_t *active;
+    size_t *next_active;
+    size_t n_active;
+    size_t n_next;
+};
+
+/*Returned een integer die aangeeft of de bitsets van 'b' gealloceerd zijn, 0 indien wel, 1 indien niet
+
+struct bitbfs *b : pointer naar de bfs toestand
+struct maze *m : pointer naar het doolhof
+
+Side effect: vult de avail bitset met alle cellen die geen muur en geen rand
+zijn en nog niet bezocht zijn*/
+static int bitbfs_init(struct bitbfs *b, struct maze *m) {
+    b->words = maze_words(m);
+    b->pitch_words = (size_t)maze_pitch(m) / BITSET_WORD_BITS;
+    b->avail = malloc(b->words * sizeof(uint64_t));
+    b->frontier = calloc(b->words, sizeof(uint64_t));
+    b->next = calloc(b->words, sizeof(uint64_t));
+    b->level_lo = calloc(b->words, sizeof(uint64_t));
+    b->level_hi = calloc(b->words, sizeof(uint64_t));
+    b->active = malloc(b->words * sizeof(size_t));
+    b->next_active = malloc(b->words * sizeof(size_t));
+    b->n_active = 0;
+    b->n_next = 0;
+    if (!b->avail || !b->frontier || !b->next || !b->level_lo || !b->level_hi
+        || !b->active || !b->next_active) {
+        return 1;
+    }
+
+    const uint64_t *walls = maze_walls(m);
+    const uint64_t *visited = maze_visited(m);
+    for (size_t w = 0; w < b->words; w++) {
+        b->avail[w] = ~walls[w] & ~visited[w];
+    }
+
+    /* De rand is nooit begaanbaar, zie maze_valid_move(). */
+    int rows = maze_rows(m);
+    int cols = maze_cols(m);
+    for (size_t w = 0; w < b->pitch_words; w++) {
+        b->avail[w] = 0;
+        b->avail[(size_t)(rows - 1) * b->pitch_words + w] = 0;
+    }
+    for (int r = 0; r < rows; r++) {
+        bitset_clear(b->avail, (size_t)maze_index(m, r, 0));
+        bitset_clear(b->avail, (size_t)maze_index(m, r, cols - 1));
+    }
+    return 0;
+}
+
+/*struct bitbfs *b : pointer naar de bfs toestand
+
+Side effect: freed alle bitsets en lijsten van 'b'*/
+static void bitbfs_cleanup(struct bitbfs *b) {
+    free(b->avail);
+    free(b->frontier);
+    free(b->next);
+    free(b->level_lo);
+    free(b->level_hi);
+    free(b->active);
+    free(b->next_active);
+}
+
+/*struct bitbfs *b : pointer naar de bfs toestand
+size_t w : het woord waar cellen bij komen
+uint64_t bits : de cellen die vanuit het frontier bereikt worden
+
+Side effect: voegt de nog niet bezochte, open cellen van 'bits' toe aan het
+volgende frontier*/
+static inline void bitbfs_reach(struct bitbfs *b, size_t w, uint64_t bits) {
+    bits &= b->avail[w];
+    if (bits == 0) {
+        return;
+    }
+    if (b->next[w] == 0) {
+        b->next_active[b->n_next++] = w;
+    }
+    b->next[w] |= bits;
+}
+
+/*Returned het level modulo 3 waarop cel 'i' bereikt is.
+
+const struct bitbfs *b : pointer naar de bfs toestand
+size_t i : index van de cel*/
+static inline int bitbfs_level(const struct bitbfs *b, size_t i) {
+    return (int)bitset_get(b->level_lo, i) | (int)bitset_get(b->level_hi, i) << 1;
+}
+
+/*Returned de lengte van het pad.
+
+struct maze *m : pointer naar het doolhof
+const struct bitbfs *b : pointer naar de bfs toestand
+int length : het level waarop de bestemming bereikt is
+
+Side effect: markeert het pad van de bestemming terug naar de start als PATH,
+zonder de start*/
+static int bitbfs_backtrack(struct maze *m, const struct bitbfs *b, int length) {
+    const uint64_t *visited = maze_visited(m);
+    int pitch = maze_pitch(m);
+    int r, c;
+    maze_destination(m, &r, &c);
+    int64_t index = maze_index(m, r, c);
+
+    for (int level = length; level > 0; level--) {
+        maze_set(m, maze_row(m, index), maze_col(m, index), PATH);
+        for (int i = 0; i < N_MOVES; i++) {
+            int64_t from = index - (m_offsets[i][0] * pitch + m_offsets[i][1]);
+            if (bitset_get(visited, (size_t)from)
+                && bitbfs_level(b, (size_t)from) == (level - 1) % 3) {
+                index = from;
+                break;
+            }
+        }
+    }
+    return length;
+}
+
+/*Implementeert bfs met een bit-parallel frontier, deze returned hierbij
+de lengte van kortste pad.
+
+struct maze *m = een struct maze pointer naar m
+
+side effects: de bezochte cellen en het pad worden gemarkeerd in m
+*/
+int bitbfs_solve(struct maze *m) {
+    struct bitbfs b;
+    if (bitbfs_init(&b, m) != 0) {
+        bitbfs_cleanup(&b);
+        return ERROR;
+    }
+
+    uint64_t *visited = maze_visited(m);
+    int r, c;
+    maze_destination(m, &r, &c);
+    size_t dest_index = (size_t)maze_index(m, r, c);
+    maze_start(m, &r, &c);
+    size_t start_index = (size_t)maze_index(m, r, c);
+
+    bitset_set(b.frontier, start_index);
+    bitset_set(visited, start_index);
+    bitset_clear(b.avail, start_index);
+    b.active[b.n_active++] = start_index / BITSET_WORD_BITS;
+
+    int level = 0;
+    while (b.n_active > 0 && !bitset_get(visited, dest_index)) {
+        level++;
+        for (size_t a = 0; a < b.n_active; a++) {
+            size_t w = b.active[a];
+            uint64_t f = b.frontier[w];
+
+            /* Links en rechts binnen het woord, met de rand cellen naar
+            het buur woord. Rijen beginnen altijd op een nieuw woord en de
+            rand is nooit open, dus er lekt niets naar de volgende rij. */
+            bitbfs_reach(&b, w, f << 1 | f >> 1);
+            if ((f & 1) && w > 0) {
+                bitbfs_reach(&b, w - 1, f << (BITSET_WORD_BITS - 1));
+            }
+            if ((f >> (BITSET_WORD_BITS - 1)) && w + 1 < b.words) {
+                bitbfs_reach(&b, w + 1, f >> (BITSET_WORD_BITS - 1));
+            }
+            if (w >= b.pitch_words) {
+                bitbfs_reach(&b, w - b.pitch_words, f);
+            }
+            if (w + b.pitch_words < b.words) {
+                bitbfs_reach(&b, w + b.pitch_words, f);
+            }
+            b.frontier[w] = 0;
+        }
+
+        int code = level % 3;
+        for (size_t a = 0; a < b.n_next; a++) {
+            size_t w = b.next_active[a];
+            visited[w] |= b.next[w];
+            b.avail[w] &= ~b.next[w];
+            if (code & 1) {
+                b.level_lo[w] |= b.next[w];
+            }
+            if (code & 2) {
+                b.level_hi[w] |= b.next[w];
+            }
+        }
+
+        uint64_t *swap = b.frontier;
+        b.frontier = b.next;
+        b.next = swap;
+        size_t *swap_active = b.active;
+        b.active = b.next_active;
+        b.next_active = swap_active;
+        b.n_active = b.n_next;
+        b.n_next = 0;
+    }
+
+    int length = NOT_FOUND;
+    if (bitset_get(visited, dest_index)) {
+        length = bitbfs_backtrack(m, &b, level);
+    }
+    bitbfs_cleanup(&b);
+    return length;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output;
+    if (output_options(&output, argc, argv) != 0) {
+        printf("Usage: %s " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    double start = timer_ms();
+    int path_length = bitbfs_solve(m);
+    double elapsed = timer_ms() - start;
+    fprintf(stderr, "bitbfs visited %zu cells in %.3f ms\n",
+            maze_count_visited(m), elapsed);
+    if (path_length == ERROR) {
+        printf("bitbfs failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("bitbfs found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
@@ -1,79 +1,22 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <unistd.h>
 
+#include "bitset.h"
 #include "maze.h"
+#include "output.h"
+#include "pred.h"
 #include "stack.h"
+#include "timer.h"
 
 #define NOT_FOUND -1
 #define ERROR -2
-#define STACK_SIZE 4000
-
-/*Returned de lengte van het pad door het doolhof
-
-Struct maze *m = de struct maze pointer m
-int **visitarray = de 2d array die de indexen van de voorgaande 
-stappen in  het doolhof bevat
-int dest_r = de rij van het doelwit
-int dest_c = de kolom van het doelwit
-
-Side effect: De visist array wordt gevuld met indexen van punten 
-in het doolhof*/
-int backtrack(struct maze *m, int **visitarray, int dest_r, int dest_c) {
-    int lengte = 0;
-    int array_index = visitarray[dest_r][dest_c];
-
-    maze_set(m, dest_r, dest_c, 'x');
-    lengte++;
-
-    while (!maze_at_start(m, maze_row(m, array_index), maze_col(m, array_index))) {
-        int r = maze_row(m, array_index);
-        int c = maze_col(m, array_index);
-
-        maze_set(m, r, c, 'x');
-
-        array_index = visitarray[r][c];
-        lengte++;
-    }
-    return lengte;
-}
-
-/* int **visitarray = de 2d array die de indexen van de voorgaande stappen in 
-het doolhof bevat
-int total_size = de lengte of breedte van het doolhof
-
-Side effect: Freed het doolhof
-*/
-void free_visitarray(int **visitarray, int total_size) {
-    for (int i = 0; i < total_size; i++) {
-        free(visitarray[i]);
-    }
-    free(visitarray);
-}
-
-/* Returned de gealloceerde en geinitialliseerde int** naar de
-visitarray op de heap of NULL als dat niet is gelukt.
-
-int r: de lengte van het doolhof
-int c: de breedte van het doolhof*/
-int **create_visitarray(int r, int c) {
-    size_t rows = (size_t)r;
-    size_t cols = (size_t)c;
-
-    int **visitarray = (int**)malloc(rows * (sizeof(int*)));
-    if (visitarray == NULL) {
-        return NULL;
-    }
-
-    for (int i = 0; i < r; i++) {
-    visitarray[i] = (int*)malloc(cols * sizeof(int));
-        if (visitarray[i] == NULL) {
-            free(visitarray); 
-            return NULL;
-        }
-    }
-    return visitarray;
-}
+/* Begin grote van de stack, de stack groeit zelf als hij vol is. */
+#define STACK_START_SIZE 1024
 
 /*Implementeert het dfs_solve algoritme, deze returned hierbij
 de lengte een juist pad.
@@ -83,57 +26,84 @@ struct maze *m = een struct maze pointer naar m
 side effects: de stack wordt ge-cleanupd
 */
 int dfs_solve(struct maze *m) {
-    int total_size = 0;
     int dest_r, dest_c;
     maze_destination(m, &dest_r, &dest_c);
-    int dest_index = maze_index(m, dest_r, dest_c);
+    int64_t dest_index = maze_index(m, dest_r, dest_c);
 
-    struct stack *stack = stack_init(STACK_SIZE);
+    struct stack *stack = stack_init(STACK_START_SIZE);
         if (stack == NULL) {
             return ERROR;
         }
 
-    total_size = maze_size(m);
-    int **visitarray = create_visitarray(total_size, total_size);
-        if (visitarray == NULL) {
+    struct pred *pred = pred_init((size_t)maze_cells(m));
+        if (pred == NULL) {
+            stack_cleanup(stack);
             return ERROR;
         }
 
+    const uint64_t *walls = maze_walls(m);
+    const int64_t *steps = maze_steps(m);
+    uint64_t *visited = maze_visited(m);
+
     int r_start, c_start = 0;
     maze_start(m, &r_start, &c_start);
-    stack_push(stack, maze_index(m, r_start, c_start));
+    int64_t start_index = maze_index(m, r_start, c_start);
+    if (stack_push(stack, start_index) != 0) {
+        pred_cleanup(pred);
+        stack_cleanup(stack);
+        return ERROR;
+    }
+    bitset_set(visited, (size_t)start_index);
 
     while (stack_empty(stack) == 0) {
-        int current_index = stack_pop(stack);
-        int current_r = maze_row(m, current_index);
-        int current_c = maze_col(m, current_index);
+        int64_t current_index = stack_pop(stack);
 
         if (current_index == dest_index) {
-            int lengte = backtrack(m, visitarray, dest_r, dest_c);
-            free_visitarray(visitarray, total_size);
+            int lengte = pred_backtrack(m, pred);
+            pred_cleanup(pred);
             stack_cleanup(stack);
             return lengte;
         }
 
-        for(int i = 0; i < 4; i ++) {
-            int r_new = current_r + m_offsets[i][0];
-            int c_new = current_c + m_offsets[i][1];
-
-            maze_set(m, current_r, current_c, VISITED);
-
-            if (maze_get(m, r_new, c_new) != WALL && maze_get(m, r_new, c_new) != VISITED && maze_valid_move(m, r_new, c_new)) {
-                stack_push(stack, maze_index(m, r_new, c_new));
-                visitarray[r_new][c_new] = current_index;
-                maze_set(m, r_new, c_new, TO_VISIT);
+        /* Alleen open cellen komen in de stack en de rand is altijd een
+        muur, dus een buur ligt altijd binnen het doolhof. */
+        for (int i = 0; i < N_MOVES; i++) {
+            size_t new_index = (size_t)maze_step(m, steps, current_index, i);
+
+            if (!bitset_get(walls, new_index) && !bitset_get(visited, new_index)) {
+                if (stack_push(stack, (int64_t)new_index) != 0) {
+                    pred_cleanup(pred);
+                    stack_cleanup(stack);
+                    return ERROR;
+                }
+                pred_set(pred, new_index, i);
+                bitset_set(visited, new_index);
             }
         }
     }
-    free_visitarray(visitarray, total_size);
+    pred_cleanup(pred);
     stack_cleanup(stack);
     return NOT_FOUND; 
 }
 
-int main(void) {
+int main(int argc, char *argv[]) {
+    /* -c kijkt eerst met de componenten of er wel een pad is. */
+    bool check_components = false;
+    struct output output = { true, 0 };
+    int option;
+    while ((option = getopt(argc, argv, "c" OUTPUT_OPTIONS)) != -1) {
+        if (option == 'c') {
+            check_components = true;
+        } else if (!output_option(&output, option, optarg)) {
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc) {
+        printf("Usage: %s [-c] " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
     /* read maze */
     struct maze *m = maze_read();
     if (!m) {
@@ -142,7 +112,16 @@ int main(void) {
     }
 
     /* solve maze */
-    int path_length = dfs_solve(m);
+    int path_length = check_components ? output_precheck(m, "dfs") : 1;
+    double start = timer_ms();
+    if (path_length == 1) {
+        path_length = dfs_solve(m);
+    } else {
+        path_length = path_length == 0 ? NOT_FOUND : ERROR;
+    }
+    double elapsed = timer_ms() - start;
+    fprintf(stderr, "dfs visited %zu cells in %.3f ms\n", maze_count_visited(m),
+            elapsed);
     if (path_length == ERROR) {
         printf("dfs failed\n");
         maze_cleanup(m);
@@ -155,8 +134,7 @@ int main(void) {
     printf("dfs found a path of length: %d\n", path_length);
 
     /* print maze */
-    maze_print(m, false);
-    maze_output_ppm(m, "out.ppm");
+    output_maze(m, &output);
 
     maze_cleanup(m);
 
@@ -0,0 +1,180 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "bitset.h"
+#include "maze.h"
+#include "output.h"
+#include "pred.h"
+#include "queue.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+/* Een stap kost hoogstens MAX_COST, dus alle cellen in de buckets liggen
+binnen MAX_COST van de huidige afstand en zijn N_BUCKETS buckets genoeg. */
+#define N_BUCKETS (MAX_COST + 1)
+/* Begin grote van elke bucket, de buckets groeien zelf als ze vol zijn. */
+#define BUCKET_START_SIZE 1024
+
+/* Dijkstra met de bucket queue van Dial: bucket d % N_BUCKETS bevat de
+cellen met afstand d. De buckets worden op volgorde van afstand leeg gemaakt,
+zodat elke push en pop O(1) is in plaats van O(log n) met een heap.
+
+Net als bij astar is de waarde in een bucket de index van de cel maal
+N_MOVES plus de zet waarmee de cel bereikt is. Een cel kan vaker in de
+buckets staan, alleen de eerste keer dat hij eruit komt telt. */
+struct dial {
+    struct queue *buckets[N_BUCKETS];
+    size_t pending;
+};
+
+/*struct dial *d : de bucket queue
+
+Side effect: freed de buckets van 'd'*/
+static void dial_cleanup(struct dial *d) {
+    for (int i = 0; i < N_BUCKETS; i++) {
+        queue_cleanup(d->buckets[i]);
+    }
+}
+
+/*Returned een integer die aangeeft of de bucket queue gemaakt is, 0 indien wel, 1 indien niet*/
+static int dial_init(struct dial *d) {
+    d->pending = 0;
+    int failed = 0;
+    for (int i = 0; i < N_BUCKETS; i++) {
+        d->buckets[i] = queue_init(BUCKET_START_SIZE);
+        failed |= d->buckets[i] == NULL;
+    }
+    return failed;
+}
+
+/*Returned een integer die aangeeft of 'entry' met afstand 'dist' in de
+bucket queue gezet is, 0 indien wel, 1 indien niet*/
+static int dial_push(struct dial *d, int64_t dist, int64_t entry) {
+    if (queue_push(d->buckets[dist % N_BUCKETS], entry) != 0) {
+        return 1;
+    }
+    d->pending++;
+    return 0;
+}
+
+/*Implementeert Dijkstra met een bucket queue, deze returned hierbij de
+lengte van het goedkoopste pad in stappen.
+
+struct maze *m = een struct maze pointer naar m
+int64_t *cost = de totale kosten van het pad
+long *expansions = het aantal cellen dat uitgebreid is
+
+side effects: de buckets worden ge-cleanupd, de uitgebreide cellen worden als
+VISITED gemarkeerd
+*/
+int dijkstra_solve(struct maze *m, int64_t *cost, long *expansions) {
+    int r, c;
+    maze_destination(m, &r, &c);
+    int64_t dest_index = maze_index(m, r, c);
+
+    struct dial dial;
+    struct pred *pred = pred_init((size_t)maze_cells(m));
+    maze_start(m, &r, &c);
+    int64_t start_index = maze_index(m, r, c);
+    if (dial_init(&dial) != 0 || pred == NULL
+        || dial_push(&dial, 0, start_index * N_MOVES) != 0) {
+        dial_cleanup(&dial);
+        pred_cleanup(pred);
+        return ERROR;
+    }
+
+    const uint64_t *walls = maze_walls(m);
+    const int64_t *steps = maze_steps(m);
+    const uint8_t *costs = maze_costs(m);
+    uint64_t *closed = maze_visited(m);
+    *expansions = 0;
+
+    int length = NOT_FOUND;
+    for (int64_t dist = 0; dial.pending > 0 && length == NOT_FOUND; dist++) {
+        struct queue *bucket = dial.buckets[dist % N_BUCKETS];
+        while (queue_empty(bucket) == 0 && length == NOT_FOUND) {
+            int64_t entry = queue_pop(bucket);
+            dial.pending--;
+            int64_t current_index = entry / N_MOVES;
+            if (bitset_get(closed, (size_t)current_index)) {
+                continue;
+            }
+            bitset_set(closed, (size_t)current_index);
+            if (current_index != start_index) {
+                pred_set(pred, (size_t)current_index, (int)(entry % N_MOVES));
+            }
+            (*expansions)++;
+
+            if (current_index == dest_index) {
+                *cost = dist;
+                length = pred_backtrack(m, pred);
+                break;
+            }
+
+            for (int i = 0; i < N_MOVES; i++) {
+                size_t new_index = (size_t)maze_step(m, steps, current_index, i);
+
+                if (!bitset_get(walls, new_index) && !bitset_get(closed, new_index)) {
+                    int step = costs ? costs[new_index] : 1;
+                    if (dial_push(&dial, dist + step,
+                                  (int64_t)new_index * N_MOVES + i) != 0) {
+                        length = ERROR;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    dial_cleanup(&dial);
+    pred_cleanup(pred);
+    return length;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output;
+    if (output_options(&output, argc, argv) != 0) {
+        printf("Usage: %s " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    long expansions = 0;
+    int64_t cost = 0;
+    double start = timer_ms();
+    int path_length = dijkstra_solve(m, &cost, &expansions);
+    fprintf(stderr, "dijkstra expanded %ld cells in %.3f ms\n", expansions,
+            timer_ms() - start);
+    if (path_length == ERROR) {
+        printf("dijkstra failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    /* Zonder terrein zijn de kosten gelijk aan de lengte. */
+    if (maze_costs(m) == NULL) {
+        printf("dijkstra found a path of length: %d\n", path_length);
+    } else {
+        printf("dijkstra found a path of length: %d with cost: %ld\n",
+               path_length, (long)cost);
+    }
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "field.h"
+#include "maze.h"
+#include "output.h"
+#include "timer.h"
+
+/* Lost het doolhof met een afstandsveld: een bfs vanaf de bestemming slaat
+voor elke cel de richting naar de bestemming op, daarna is het pad vanaf elke
+start te vinden door de richtingen te volgen. Het veld kan met -s opgeslagen
+worden en met -l weer geladen, zodat de bfs niet opnieuw hoeft voor hetzelfde
+doolhof. Na de opties kunnen extra starts als 'rij,kolom' gegeven worden,
+daarvan wordt alleen de lengte van het pad geprint. */
+
+/*Returned een integer die aangeeft of 'arg' een cel als 'rij,kolom' is, 1
+indien wel, 0 indien niet
+
+const char *arg : het argument
+int *r, int *c : de rij en kolom van de cel*/
+static int parse_cell(const char *arg, int *r, int *c) {
+    char *end;
+    *r = (int)strtol(arg, &end, 10);
+    if (*end != ',') {
+        return 0;
+    }
+    *c = (int)strtol(end + 1, &end, 10);
+    return *end == '\0';
+}
+
+int main(int argc, char *argv[]) {
+    const char *save_file = NULL;
+    const char *load_file = NULL;
+    struct output output = { true, 0 };
+    int option;
+    while ((option = getopt(argc, argv, "s:l:" OUTPUT_OPTIONS)) != -1) {
+        if (option == 's') {
+            save_file = optarg;
+        } else if (option == 'l') {
+            load_file = optarg;
+        } else if (!output_option(&output, option, optarg)) {
+            optind = argc + 1;
+            break;
+        }
+    }
+    int r, c;
+    for (int i = optind; i < argc; i++) {
+        if (!parse_cell(argv[i], &r, &c)) {
+            optind = argc + 1;
+        }
+    }
+    if (optind > argc) {
+        printf("Usage: %s [-s save_file] [-l load_file] " OUTPUT_USAGE
+               " [row,col ...]\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* build or load the field */
+    double start = timer_ms();
+    struct field *f = load_file ? field_load(m, load_file) : field_build(m);
+    if (f == NULL) {
+        printf(load_file ? "field does not match the maze or could not be read\n"
+                         : "field failed\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    fprintf(stderr, "field %s %zu cells in %.3f ms\n",
+            load_file ? "loaded" : "reached", field_reached(f), timer_ms() - start);
+    if (save_file && field_save(f, save_file) != 0) {
+        printf("Error writing field to %s\n", save_file);
+        field_cleanup(f);
+        maze_cleanup(m);
+        return 1;
+    }
+
+    /* solve maze */
+    start = timer_ms();
+    maze_start(m, &r, &c);
+    int path_length = field_path(f, m, r, c, true);
+    for (int i = optind; i < argc; i++) {
+        int query_r, query_c;
+        parse_cell(argv[i], &query_r, &query_c);
+        int length = field_path(f, m, query_r, query_c, false);
+        if (length < 0) {
+            printf("from (%d, %d) no path\n", query_r, query_c);
+        } else {
+            printf("from (%d, %d) path length: %d\n", query_r, query_c, length);
+        }
+    }
+    fprintf(stderr, "field answered %d queries in %.3f ms\n", argc - optind + 1,
+            timer_ms() - start);
+    field_cleanup(f);
+    if (path_length < 0) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("field found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
@@ -0,0 +1,345 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "heap.h"
+#include "maze.h"
+#include "output.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+#define NO_JUMP -1
+/* Begin grote van de heap, de heap groeit zelf als hij vol is. */
+#define HEAP_START_SIZE 1024
+/* Begin grote van de lijst met sprongpunt records. */
+#define RECORDS_START_SIZE 1024
+
+/* Jump Point Search voor een doolhof met vier richtingen. Van alle kortste
+paden wordt alleen het pad gezocht dat zo vroeg mogelijk verticaal gaat: na
+een horizontale stap mag er alleen verticaal afgeslagen worden als de cel
+schuin achter de zijbuur een muur is (een geforceerde buur), na een
+verticale stap mag altijd horizontaal afgeslagen worden. Horizontale sprongen
+stoppen bij een geforceerde buur, verticale sprongen stoppen bij een cel van
+waaruit een horizontale sprong een sprongpunt vindt. Alleen sprongpunten komen
+in de heap.
+
+Van de sprongpunten die in de heap gaan wordt een record bijgehouden met het
+record van het sprongpunt ervoor, het pad wordt aan het eind via die records
+terug gelopen. Een tussenliggend sprongpunt hoeft niet via een kortste pad
+uitgebreid te zijn, dus de voorgangers kunnen niet per cel opgeslagen worden
+zoals bij bfs. */
+struct jump_record {
+    int64_t index;
+    int move;
+    int64_t parent;
+};
+
+struct jps {
+    const struct maze *m;
+    uint64_t *blocked;
+    uint64_t *expanded;
+    struct jump_record *records;
+    size_t n_records;
+    size_t records_capacity;
+    int step[N_MOVES];
+    int64_t dest_index;
+};
+
+/*Returned true als cel 'i' een muur of een rand cel is.*/
+static inline bool jps_blocked(const struct jps *j, int64_t i) {
+    return bitset_get(j->blocked, (size_t)i);
+}
+
+/*Returned true als 'move' een horizontale zet is (rechts of links).*/
+static inline bool horizontal(int move) {
+    return m_offsets[move][0] == 0;
+}
+
+/*Returned het sprongpunt dat gevonden wordt door vanaf 'index' horizontaal
+in richting 'move' te lopen, of NO_JUMP als de sprong tegen een muur eindigt.
+
+const struct jps *j : de zoek toestand
+int64_t index : de cel waar de sprong begint
+int move : de richting van de sprong*/
+static int64_t jump_horizontal(const struct jps *j, int64_t index, int move) {
+    int step = j->step[move];
+    int up = j->step[0];
+    for (;;) {
+        index += step;
+        if (jps_blocked(j, index)) {
+            return NO_JUMP;
+        }
+        if (index == j->dest_index) {
+            return index;
+        }
+        /* Een geforceerde buur boven of onder. */
+        if ((!jps_blocked(j, index - up) && jps_blocked(j, index - step - up))
+            || (!jps_blocked(j, index + up) && jps_blocked(j, index - step + up))) {
+            return index;
+        }
+    }
+}
+
+/*Returned het sprongpunt dat gevonden wordt door vanaf 'index' verticaal in
+richting 'move' te lopen, of NO_JUMP als de sprong tegen een muur eindigt.
+
+const struct jps *j : de zoek toestand
+int64_t index : de cel waar de sprong begint
+int move : de richting van de sprong*/
+static int64_t jump_vertical(const struct jps *j, int64_t index, int move) {
+    int step = j->step[move];
+    for (;;) {
+        index += step;
+        if (jps_blocked(j, index)) {
+            return NO_JUMP;
+        }
+        if (index == j->dest_index
+            || jump_horizontal(j, index, 1) != NO_JUMP
+            || jump_horizontal(j, index, 3) != NO_JUMP) {
+            return index;
+        }
+    }
+}
+
+/*Returned het sprongpunt in richting 'move' vanaf 'index', of NO_JUMP.*/
+static int64_t jump(const struct jps *j, int64_t index, int move) {
+    return horizontal(move) ? jump_horizontal(j, index, move)
+                            : jump_vertical(j, index, move);
+}
+
+/*Returned de Manhattan afstand tussen de cellen 'a' en 'b'.*/
+static int distance(const struct maze *m, int64_t a, int64_t b) {
+    return abs(maze_row(m, a) - maze_row(m, b))
+           + abs(maze_col(m, a) - maze_col(m, b));
+}
+
+/*Returned het nummer van een nieuw record voor sprongpunt 'index', bereikt
+met zet 'move' vanaf het record 'parent', of -1 als er geen geheugen is.
+
+struct jps *j : de zoek toestand*/
+static int64_t add_record(struct jps *j, int64_t index, int move,
+                          int64_t parent) {
+    if (j->n_records == j->records_capacity) {
+        size_t capacity = 2 * j->records_capacity;
+        struct jump_record *grown = realloc(j->records,
+                                            capacity * sizeof(struct jump_record));
+        if (grown == NULL) {
+            return -1;
+        }
+        j->records = grown;
+        j->records_capacity = capacity;
+    }
+    j->records[j->n_records].index = index;
+    j->records[j->n_records].move = move;
+    j->records[j->n_records].parent = parent;
+    return (int64_t)j->n_records++;
+}
+
+/*Returned een integer die aangeeft of het sprongpunt in richting 'move' vanaf
+het record 'parent' in de heap gezet is of niet bestaat, 0 indien zo, 1 indien
+het pushen mislukt is.
+
+struct jps *j : de zoek toestand
+struct heap *heap : de open lijst
+int64_t parent : het record van het sprongpunt dat uitgebreid wordt
+int g : de lengte van het pad tot het sprongpunt
+int move : de richting om in te springen*/
+static int push_jump(struct jps *j, struct heap *heap, int64_t parent, int g,
+                     int move) {
+    int64_t index = j->records[parent].index;
+    int64_t next = jump(j, index, move);
+    if (next == NO_JUMP) {
+        return 0;
+    }
+    int g_next = g + distance(j->m, index, next);
+    int f = g_next + distance(j->m, next, j->dest_index);
+    int64_t record = add_record(j, next, move, parent);
+    return record < 0 || heap_push(heap, heap_key(f, g_next), record) != 0;
+}
+
+/*Returned een integer die aangeeft of de zoek toestand gemaakt is, 0 indien wel, 1 indien niet
+
+struct jps *j : de zoek toestand
+struct maze *m : pointer naar het doolhof
+
+Side effect: vult de blocked bitset met de muren en de rand van het doolhof*/
+static int jps_init(struct jps *j, struct maze *m) {
+    j->m = m;
+    j->blocked = malloc(maze_words(m) * sizeof(uint64_t));
+    j->expanded = calloc(N_MOVES * maze_words(m), sizeof(uint64_t));
+    j->records_capacity = RECORDS_START_SIZE;
+    j->n_records = 0;
+    j->records = malloc(j->records_capacity * sizeof(struct jump_record));
+    if (!j->blocked || !j->expanded || !j->records) {
+        return 1;
+    }
+    memcpy(j->blocked, maze_walls(m), maze_words(m) * sizeof(uint64_t));
+
+    int rows = maze_rows(m);
+    int cols = maze_cols(m);
+    for (int c = 0; c < cols; c++) {
+        bitset_set(j->blocked, (size_t)maze_index(m, 0, c));
+        bitset_set(j->blocked, (size_t)maze_index(m, rows - 1, c));
+    }
+    for (int r = 0; r < rows; r++) {
+        bitset_set(j->blocked, (size_t)maze_index(m, r, 0));
+        bitset_set(j->blocked, (size_t)maze_index(m, r, cols - 1));
+    }
+
+    for (int i = 0; i < N_MOVES; i++) {
+        j->step[i] = m_offsets[i][0] * maze_pitch(m) + m_offsets[i][1];
+    }
+    int r, c;
+    maze_destination(m, &r, &c);
+    j->dest_index = maze_index(m, r, c);
+    return 0;
+}
+
+/*struct jps *j : de zoek toestand
+
+Side effect: freed de bitsets en records van 'j'*/
+static void jps_cleanup(struct jps *j) {
+    free(j->blocked);
+    free(j->expanded);
+    free(j->records);
+}
+
+/*struct maze *m : pointer naar het doolhof
+const struct jps *j : de zoek toestand
+int64_t record : het record van de bestemming
+
+Side effect: markeert de rechte stukken tussen de sprongpunten van de
+bestemming terug naar de start als PATH, zonder de start*/
+static void jps_mark_path(struct maze *m, const struct jps *j, int64_t record) {
+    while (j->records[record].parent >= 0) {
+        const struct jump_record *jump_point = &j->records[record];
+        int64_t from = j->records[jump_point->parent].index;
+        for (int64_t cell = jump_point->index; cell != from;
+             cell -= j->step[jump_point->move]) {
+            maze_set(m, maze_row(m, cell), maze_col(m, cell), PATH);
+        }
+        record = jump_point->parent;
+    }
+}
+
+/*Implementeert Jump Point Search, deze returned hierbij de lengte van
+kortste pad.
+
+struct maze *m = een struct maze pointer naar m
+long *expansions = het aantal sprongpunten dat uitgebreid is
+
+side effects: de heap wordt ge-cleanupd, de uitgebreide sprongpunten worden
+als VISITED gemarkeerd
+*/
+int jps_solve(struct maze *m, long *expansions) {
+    struct jps j;
+    struct heap *heap = heap_init(HEAP_START_SIZE);
+    if (jps_init(&j, m) != 0 || !heap) {
+        jps_cleanup(&j);
+        heap_cleanup(heap);
+        return ERROR;
+    }
+
+    /* Een sprongpunt wordt per richting waarmee het bereikt is een keer
+    uitgebreid, omdat de richting bepaalt welke buren overblijven. */
+    uint64_t *visited = maze_visited(m);
+    *expansions = 0;
+
+    int r, c;
+    maze_start(m, &r, &c);
+    int64_t start_index = maze_index(m, r, c);
+    int64_t start = add_record(&j, start_index, 0, -1);
+    bitset_set(visited, (size_t)start_index);
+
+    int length = NOT_FOUND;
+    int failed = 0;
+    if (start_index == j.dest_index) {
+        length = 0;
+    }
+    for (int i = 0; i < N_MOVES && length == NOT_FOUND; i++) {
+        failed |= push_jump(&j, heap, start, 0, i);
+    }
+
+    while (!failed && length == NOT_FOUND && heap_empty(heap) == 0) {
+        uint64_t key;
+        int64_t record = heap_pop(heap, &key);
+        int64_t index = j.records[record].index;
+        int move = j.records[record].move;
+        size_t closed = (size_t)(move * maze_cells(m) + index);
+        if (bitset_get(j.expanded, closed)) {
+            continue;
+        }
+        bitset_set(j.expanded, closed);
+        bitset_set(visited, (size_t)index);
+        (*expansions)++;
+
+        int g = (int)(UINT32_MAX - (uint32_t)key);
+        if (index == j.dest_index) {
+            jps_mark_path(m, &j, record);
+            length = g;
+            break;
+        }
+
+        failed |= push_jump(&j, heap, record, g, move);
+        if (horizontal(move)) {
+            int step = j.step[move];
+            for (int side = 0; side < N_MOVES; side += 2) {
+                int side_step = j.step[side];
+                if (!jps_blocked(&j, index + side_step)
+                    && jps_blocked(&j, index - step + side_step)) {
+                    failed |= push_jump(&j, heap, record, g, side);
+                }
+            }
+        } else {
+            failed |= push_jump(&j, heap, record, g, 1);
+            failed |= push_jump(&j, heap, record, g, 3);
+        }
+    }
+
+    jps_cleanup(&j);
+    heap_cleanup(heap);
+    return failed ? ERROR : length;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output;
+    if (output_options(&output, argc, argv) != 0) {
+        printf("Usage: %s " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    long expansions = 0;
+    double start = timer_ms();
+    int path_length = jps_solve(m, &expansions);
+    fprintf(stderr, "jps expanded %ld cells in %.3f ms\n", expansions,
+            timer_ms() - start);
+    if (path_length == ERROR) {
+        printf("jps failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("jps found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
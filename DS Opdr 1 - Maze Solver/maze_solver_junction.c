@@ -0,0 +1,375 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "heap.h"
+#include "maze.h"
+#include "output.h"
+#include "stack.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+#define NO_EDGE -1
+/* Begin grote van de heap en de stack, ze groeien zelf als ze vol zijn. */
+#define HEAP_START_SIZE 1024
+#define STACK_START_SIZE 1024
+
+/* Lost het doolhof op via een kleinere graaf. Eerst worden doodlopende
+gangen dichtgezet (dead-end filling), daarna is elke open cel met precies
+twee open buren een gangcel. De overige open cellen, plus de start en de
+bestemming, zijn knooppunten. Een gang tussen twee knooppunten wordt een kant
+met als gewicht de lengte van de gang. Dijkstra zoekt op de knooppunten en
+het gevonden pad wordt weer uitgepakt tot PATH cellen.
+
+Knooppunten krijgen een nummer via hun rang in de 'nodes' bitset: het aantal
+knooppunten in de woorden ervoor (first_node) plus de bits ervoor in het
+eigen woord. Zo is er geen array met een entry per cel nodig. */
+struct junction {
+    const struct maze *m;
+    uint64_t *blocked;
+    uint64_t *nodes;
+    int64_t *first_node;
+    int64_t n_nodes;
+    int64_t *node_cell;
+    /* Per knooppunt en richting: het knooppunt aan het eind van de gang en
+    de lengte van de gang, of NO_EDGE. */
+    int64_t *edge_to;
+    int *edge_length;
+    int step[N_MOVES];
+    int64_t start_index;
+    int64_t dest_index;
+};
+
+/*Returned true als cel 'i' een muur, een rand cel of dichtgezet is.*/
+static inline bool junction_blocked(const struct junction *j, int64_t i) {
+    return bitset_get(j->blocked, (size_t)i);
+}
+
+/*Returned het aantal open buren van cel 'i'.*/
+static int open_neighbours(const struct junction *j, int64_t i) {
+    int open = 0;
+    for (int move = 0; move < N_MOVES; move++) {
+        open += !junction_blocked(j, i + j->step[move]);
+    }
+    return open;
+}
+
+/*Returned true als cel 'i' een doodlopende gang is die dicht mag.*/
+static bool dead_end(const struct junction *j, int64_t i) {
+    return !junction_blocked(j, i) && i != j->start_index && i != j->dest_index
+           && open_neighbours(j, i) <= 1;
+}
+
+/*Returned het nummer van knooppunt 'i'.*/
+static inline int64_t node_id(const struct junction *j, int64_t i) {
+    size_t word = (size_t)i / BITSET_WORD_BITS;
+    uint64_t before = ((uint64_t)1 << ((size_t)i % BITSET_WORD_BITS)) - 1;
+    return j->first_node[word] + __builtin_popcountll(j->nodes[word] & before);
+}
+
+/*Returned een integer die aangeeft of de zoek toestand gemaakt is, 0 indien wel, 1 indien niet
+
+struct junction *j : de zoek toestand
+struct maze *m : pointer naar het doolhof
+
+Side effect: vult de blocked bitset met de muren en de rand van het doolhof*/
+static int junction_init(struct junction *j, const struct maze *m) {
+    memset(j, 0, sizeof(struct junction));
+    j->m = m;
+    j->blocked = malloc(maze_words(m) * sizeof(uint64_t));
+    j->nodes = calloc(maze_words(m), sizeof(uint64_t));
+    j->first_node = malloc(maze_words(m) * sizeof(int64_t));
+    if (!j->blocked || !j->nodes || !j->first_node) {
+        return 1;
+    }
+    memcpy(j->blocked, maze_walls(m), maze_words(m) * sizeof(uint64_t));
+
+    int rows = maze_rows(m);
+    int cols = maze_cols(m);
+    for (int c = 0; c < cols; c++) {
+        bitset_set(j->blocked, (size_t)maze_index(m, 0, c));
+        bitset_set(j->blocked, (size_t)maze_index(m, rows - 1, c));
+    }
+    for (int r = 0; r < rows; r++) {
+        bitset_set(j->blocked, (size_t)maze_index(m, r, 0));
+        bitset_set(j->blocked, (size_t)maze_index(m, r, cols - 1));
+    }
+
+    for (int i = 0; i < N_MOVES; i++) {
+        j->step[i] = m_offsets[i][0] * maze_pitch(m) + m_offsets[i][1];
+    }
+    int r, c;
+    maze_start(m, &r, &c);
+    j->start_index = maze_index(m, r, c);
+    maze_destination(m, &r, &c);
+    j->dest_index = maze_index(m, r, c);
+    return 0;
+}
+
+/*struct junction *j : de zoek toestand
+
+Side effect: freed de bitsets en arrays van 'j'*/
+static void junction_cleanup(struct junction *j) {
+    free(j->blocked);
+    free(j->nodes);
+    free(j->first_node);
+    free(j->node_cell);
+    free(j->edge_to);
+    free(j->edge_length);
+}
+
+/*Returned het aantal dichtgezette cellen, of -1 als er geen geheugen is.
+
+struct junction *j : de zoek toestand
+
+Side effect: zet alle doodlopende gangen dicht in de blocked bitset. Een
+dichtgezette cel kan zijn buur doodlopend maken, die gaat dan op de stack.*/
+static int64_t fill_dead_ends(struct junction *j) {
+    struct stack *stack = stack_init(STACK_START_SIZE);
+    if (stack == NULL) {
+        return -1;
+    }
+    int64_t filled = 0;
+    int64_t cells = maze_cells(j->m);
+    for (int64_t i = 0; i < cells; i++) {
+        if (dead_end(j, i) && stack_push(stack, i) != 0) {
+            stack_cleanup(stack);
+            return -1;
+        }
+    }
+    while (stack_empty(stack) == 0) {
+        int64_t i = stack_pop(stack);
+        if (!dead_end(j, i)) {
+            continue;
+        }
+        bitset_set(j->blocked, (size_t)i);
+        filled++;
+        for (int move = 0; move < N_MOVES; move++) {
+            int64_t next = i + j->step[move];
+            if (dead_end(j, next) && stack_push(stack, next) != 0) {
+                stack_cleanup(stack);
+                return -1;
+            }
+        }
+    }
+    stack_cleanup(stack);
+    return filled;
+}
+
+/*Returned de cel van het knooppunt aan het eind van de gang die vanaf
+knooppunt 'index' in richting 'move' begint.
+
+const struct junction *j : de zoek toestand
+int64_t index : de cel van het knooppunt
+int move : de eerste stap van de gang
+int *length : de lengte van de gang
+struct maze *m : het doolhof waarin de gang als PATH gemarkeerd wordt, of
+NULL om niets te markeren*/
+static int64_t walk(const struct junction *j, int64_t index, int move,
+                    int *length, struct maze *m) {
+    *length = 0;
+    for (;;) {
+        index += j->step[move];
+        (*length)++;
+        if (m != NULL) {
+            maze_set(m, maze_row(m, index), maze_col(m, index), PATH);
+        }
+        if (bitset_get(j->nodes, (size_t)index)) {
+            return index;
+        }
+        /* Een gangcel heeft precies een open buur naast de cel waar we
+        vandaan komen. */
+        int back = (move + 2) % N_MOVES;
+        for (move = 0; move == back || junction_blocked(j, index + j->step[move]);
+             move++) {
+        }
+    }
+}
+
+/*Returned een integer die aangeeft of de graaf gemaakt is, 0 indien wel, 1 indien niet
+
+struct junction *j : de zoek toestand, met de doodlopende gangen al dicht
+
+Side effect: vult de nodes bitset en de kanten van elk knooppunt*/
+static int build_graph(struct junction *j) {
+    int64_t cells = maze_cells(j->m);
+    for (int64_t i = 0; i < cells; i++) {
+        if (!junction_blocked(j, i)
+            && (open_neighbours(j, i) != 2 || i == j->start_index
+                || i == j->dest_index)) {
+            bitset_set(j->nodes, (size_t)i);
+        }
+    }
+    j->n_nodes = 0;
+    for (size_t w = 0; w < maze_words(j->m); w++) {
+        j->first_node[w] = j->n_nodes;
+        j->n_nodes += __builtin_popcountll(j->nodes[w]);
+    }
+
+    size_t n = (size_t)j->n_nodes;
+    j->node_cell = malloc(n * sizeof(int64_t));
+    j->edge_to = malloc(N_MOVES * n * sizeof(int64_t));
+    j->edge_length = malloc(N_MOVES * n * sizeof(int));
+    if (!j->node_cell || !j->edge_to || !j->edge_length) {
+        return 1;
+    }
+    for (int64_t i = 0; i < cells; i++) {
+        if (!bitset_get(j->nodes, (size_t)i)) {
+            continue;
+        }
+        int64_t node = node_id(j, i);
+        j->node_cell[node] = i;
+        for (int move = 0; move < N_MOVES; move++) {
+            int64_t edge = node * N_MOVES + move;
+            j->edge_to[edge] = NO_EDGE;
+            if (!junction_blocked(j, i + j->step[move])) {
+                int64_t end = walk(j, i, move, &j->edge_length[edge], NULL);
+                j->edge_to[edge] = node_id(j, end);
+            }
+        }
+    }
+    return 0;
+}
+
+/*Implementeert Dijkstra op de graaf van knooppunten, deze returned hierbij de
+lengte van kortste pad.
+
+struct maze *m = een struct maze pointer naar m
+const struct junction *j = de zoek toestand met de graaf
+long *expansions = het aantal knooppunten dat uitgebreid is
+
+side effects: de heap wordt ge-cleanupd, de uitgebreide knooppunten worden
+als VISITED gemarkeerd en het pad wordt als PATH gemarkeerd
+*/
+static int junction_search(struct maze *m, const struct junction *j,
+                           long *expansions) {
+    if (junction_blocked(j, j->start_index) || junction_blocked(j, j->dest_index)) {
+        return NOT_FOUND;
+    }
+    size_t n = (size_t)j->n_nodes;
+    int *dist = malloc(n * sizeof(int));
+    /* De kant waarlangs een knooppunt bereikt is, als knooppunt maal
+    N_MOVES plus de richting van de gang. */
+    int64_t *via = malloc(n * sizeof(int64_t));
+    struct heap *heap = heap_init(HEAP_START_SIZE);
+    int64_t start = node_id(j, j->start_index);
+    if (!dist || !via || !heap || heap_push(heap, 0, start) != 0) {
+        free(dist);
+        free(via);
+        heap_cleanup(heap);
+        return ERROR;
+    }
+    for (size_t i = 0; i < n; i++) {
+        dist[i] = INT_MAX;
+    }
+    dist[start] = 0;
+
+    uint64_t *visited = maze_visited(m);
+    int64_t dest = node_id(j, j->dest_index);
+    int length = NOT_FOUND;
+    *expansions = 0;
+    while (heap_empty(heap) == 0) {
+        uint64_t key;
+        int64_t node = heap_pop(heap, &key);
+        if (key > (uint64_t)dist[node]) {
+            continue;
+        }
+        bitset_set(visited, (size_t)j->node_cell[node]);
+        (*expansions)++;
+        if (node == dest) {
+            length = dist[node];
+            break;
+        }
+        for (int move = 0; move < N_MOVES; move++) {
+            int64_t edge = node * N_MOVES + move;
+            int64_t next = j->edge_to[edge];
+            if (next == NO_EDGE || dist[node] + j->edge_length[edge] >= dist[next]) {
+                continue;
+            }
+            dist[next] = dist[node] + j->edge_length[edge];
+            via[next] = edge;
+            if (heap_push(heap, (uint64_t)dist[next], next) != 0) {
+                length = ERROR;
+                break;
+            }
+        }
+        if (length == ERROR) {
+            break;
+        }
+    }
+
+    /* Pak het pad uit door de gangen vanaf de bestemming terug opnieuw te
+    lopen. */
+    if (length > 0) {
+        for (int64_t node = dest; node != start; node = via[node] / N_MOVES) {
+            int64_t from = via[node] / N_MOVES;
+            int corridor;
+            walk(j, j->node_cell[from], (int)(via[node] % N_MOVES), &corridor, m);
+        }
+    }
+    free(dist);
+    free(via);
+    heap_cleanup(heap);
+    return length;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output;
+    if (output_options(&output, argc, argv) != 0) {
+        printf("Usage: %s " OUTPUT_USAGE "\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* compress the maze into a graph of junctions */
+    double start = timer_ms();
+    struct junction j;
+    int64_t filled = -1;
+    if (junction_init(&j, m) == 0) {
+        filled = fill_dead_ends(&j);
+    }
+    if (filled < 0 || build_graph(&j) != 0) {
+        printf("junction failed\n");
+        junction_cleanup(&j);
+        maze_cleanup(m);
+        return 1;
+    }
+    fprintf(stderr, "junction filled %ld dead end cells and kept %ld junctions "
+            "in %.3f ms\n", (long)filled, (long)j.n_nodes, timer_ms() - start);
+
+    /* solve maze */
+    long expansions = 0;
+    start = timer_ms();
+    int path_length = junction_search(m, &j, &expansions);
+    fprintf(stderr, "junction expanded %ld cells in %.3f ms\n", expansions,
+            timer_ms() - start);
+    junction_cleanup(&j);
+    if (path_length == ERROR) {
+        printf("junction failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("junction found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Needed for clock_gettime() and getopt()
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "lpa.h"
+#include "maze.h"
+#include "output.h"
+#include "timer.h"
+
+/* Lost het doolhof met een LPA* sessie en zet daarna de muren van de
+argumenten 'rij,kolom' een voor een om. Na elke verandering wordt alleen het
+deel van de zoektocht hersteld dat door de muur veranderd is. Het pad dat
+geprint wordt is dat van het doolhof na alle veranderingen, de kosten en de
+tijd van elke stap staan op stderr. */
+
+/*Returned een integer die aangeeft of 'arg' een cel als 'rij,kolom' is, 1
+indien wel, 0 indien niet
+
+const char *arg : het argument
+int *r, int *c : de rij en kolom van de cel*/
+static int parse_cell(const char *arg, int *r, int *c) {
+    char *end;
+    *r = (int)strtol(arg, &end, 10);
+    if (*end != ',') {
+        return 0;
+    }
+    *c = (int)strtol(end + 1, &end, 10);
+    return *end == '\0';
+}
+
+int main(int argc, char *argv[]) {
+    struct output output = { true, 0 };
+    int option;
+    while ((option = getopt(argc, argv, OUTPUT_OPTIONS)) != -1) {
+        if (!output_option(&output, option, optarg)) {
+            optind = argc + 1;
+            break;
+        }
+    }
+    int r, c;
+    for (int i = optind; i < argc; i++) {
+        if (!parse_cell(argv[i], &r, &c)) {
+            optind = argc + 1;
+        }
+    }
+    if (optind > argc) {
+        printf("Usage: %s " OUTPUT_USAGE " [row,col ...]\n", argv[0]);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    struct lpa *s = lpa_init(m);
+    if (s == NULL) {
+        printf("lpa failed\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    double start = timer_ms();
+    int cost = lpa_solve(s);
+    fprintf(stderr, "lpa expanded %ld cells in %.3f ms\n", lpa_expansions(s),
+            timer_ms() - start);
+
+    /* toggle the walls and replan */
+    for (int i = optind; i < argc && cost != -2; i++) {
+        parse_cell(argv[i], &r, &c);
+        long before = lpa_expansions(s);
+        start = timer_ms();
+        if (lpa_toggle_wall(s, r, c) != 0) {
+            printf("cannot toggle (%d, %d)\n", r, c);
+            lpa_cleanup(s);
+            maze_cleanup(m);
+            return 1;
+        }
+        cost = lpa_solve(s);
+        fprintf(stderr, "lpa toggled (%d, %d) to cost %d, expanded %ld cells in "
+                "%.3f ms\n", r, c, cost, lpa_expansions(s) - before,
+                timer_ms() - start);
+    }
+
+    int path_length = cost >= 0 ? lpa_mark_path(s) : cost;
+    lpa_cleanup(s);
+    if (path_length == -2) {
+        printf("lpa failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length < 0) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    /* Zonder terrein zijn de kosten gelijk aan de lengte. */
+    if (maze_costs(m) == NULL) {
+        printf("lpa found a path of length: %d\n", path_length);
+    } else {
+        printf("lpa found a path of length: %d with cost: %d\n", path_length,
+               cost);
+    }
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
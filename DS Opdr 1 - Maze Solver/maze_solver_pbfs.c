@@ -0,0 +1,381 @@
+// Needed for pthread_barrier_t, sysconf(), getopt() and clock_gettime()
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bitset.h"
+#include "maze.h"
+#include "output.h"
+#include "pred.h"
+#include "timer.h"
+
+#define NOT_FOUND -1
+#define ERROR -2
+/* Begin grote van de frontier buffers, de buffers groeien zelf. */
+#define BUFFER_START_SIZE 1024
+/* Kleinere frontiers worden door een thread alleen uitgebreid, omdat het
+synchroniseren van de threads dan meer kost dan het werk zelf. */
+#ifndef PARALLEL_MIN_FRONTIER
+#define PARALLEL_MIN_FRONTIER 4096
+#endif
+#define MAX_THREADS 256
+
+/* Een groeiende lijst met cellen. Elke thread heeft een eigen buffer voor
+het volgende frontier, zodat de threads geen queue hoeven te delen. */
+struct cell_buffer {
+    int64_t *cells;
+    size_t size;
+    size_t capacity;
+};
+
+/* Level-synchrone parallelle bfs. Elk level wordt het frontier in gelijke
+stukken over de threads verdeeld. Een cel wordt geclaimd met een atomaire
+test-and-set op de visited bitset, alleen de thread die het bit zet zet de
+voorganger en neemt de cel op in zijn buffer. Na elk level voegt thread 0 de
+buffers samen tot het nieuwe frontier. Omdat elke cel van level L een
+voorganger op level L - 1 heeft is het gevonden pad een kortste pad. */
+struct pbfs {
+    struct maze *m;
+    uint64_t *blocked;
+    uint64_t *visited;
+    struct pred *pred;
+    int step[N_MOVES];
+    int64_t dest_index;
+
+    int64_t *frontier;
+    size_t frontier_size;
+    struct cell_buffer buffers[MAX_THREADS];
+    int n_threads;
+
+    pthread_mutex_t gate_lock;
+    pthread_cond_t gate_open;
+    bool gate;
+    pthread_barrier_t level_start;
+    pthread_barrier_t level_end;
+    bool done;
+    bool failed;
+    bool found;
+};
+
+/*Returned een integer die aangeeft of 'cell' toegevoegd is aan 'buffer', 0 indien wel, 1 indien niet*/
+static int buffer_push(struct cell_buffer *buffer, int64_t cell) {
+    if (buffer->size == buffer->capacity) {
+        size_t capacity = buffer->capacity ? 2 * buffer->capacity : BUFFER_START_SIZE;
+        int64_t *grown = realloc(buffer->cells, capacity * sizeof(int64_t));
+        if (grown == NULL) {
+            return 1;
+        }
+        buffer->cells = grown;
+        buffer->capacity = capacity;
+    }
+    buffer->cells[buffer->size++] = cell;
+    return 0;
+}
+
+/*Returned een integer die aangeeft of de buren van de cellen in
+frontier[lo, hi) allemaal verwerkt zijn, 0 indien wel, 1 indien een buffer
+niet kon groeien.
+
+struct pbfs *b : de gedeelde toestand
+size_t lo, hi : het stuk van het frontier voor deze thread
+struct cell_buffer *next : de buffer voor het volgende frontier
+
+Side effect: claimt de nog niet bezochte buren in de visited bitset*/
+static int expand_range(struct pbfs *b, size_t lo, size_t hi,
+                        struct cell_buffer *next) {
+    for (size_t n = lo; n < hi; n++) {
+        int64_t index = b->frontier[n];
+        for (int i = 0; i < N_MOVES; i++) {
+            size_t new_index = (size_t)(index + b->step[i]);
+            uint64_t *word = &b->visited[new_index / BITSET_WORD_BITS];
+            uint64_t bit = (uint64_t)1 << (new_index % BITSET_WORD_BITS);
+            if (bitset_get(b->blocked, new_index)
+                || (__atomic_load_n(word, __ATOMIC_RELAXED) & bit)) {
+                continue;
+            }
+            if (__atomic_fetch_or(word, bit, __ATOMIC_RELAXED) & bit) {
+                continue; /* Een andere thread was net eerder. */
+            }
+            pred_set_atomic(b->pred, new_index, i);
+            if (buffer_push(next, (int64_t)new_index) != 0) {
+                return 1;
+            }
+            if ((int64_t)new_index == b->dest_index) {
+                __atomic_store_n(&b->found, true, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    return 0;
+}
+
+/*Returned een integer die aangeeft of de buffers samengevoegd zijn, 0 indien wel, 1 indien niet
+
+struct pbfs *b : de gedeelde toestand
+
+Side effect: maakt het frontier gelijk aan de inhoud van alle buffers en
+maakt de buffers leeg*/
+static int gather(struct pbfs *b) {
+    size_t total = 0;
+    for (int t = 0; t < b->n_threads; t++) {
+        total += b->buffers[t].size;
+    }
+
+    int64_t *frontier = realloc(b->frontier, (total ? total : 1) * sizeof(int64_t));
+    if (frontier == NULL) {
+        return 1;
+    }
+    b->frontier = frontier;
+    b->frontier_size = 0;
+    for (int t = 0; t < b->n_threads; t++) {
+        memcpy(b->frontier + b->frontier_size, b->buffers[t].cells,
+               b->buffers[t].size * sizeof(int64_t));
+        b->frontier_size += b->buffers[t].size;
+        b->buffers[t].size = 0;
+    }
+    return 0;
+}
+
+/*Side effect: thread 0 breidt het frontier alleen uit zolang het klein is,
+en zet 'done' als de bestemming gevonden is, het frontier leeg is of er iets
+mis ging.
+
+struct pbfs *b : de gedeelde toestand*/
+static void serial_levels(struct pbfs *b) {
+    while (!b->failed && !b->found && b->frontier_size > 0
+           && b->frontier_size < PARALLEL_MIN_FRONTIER) {
+        b->failed = expand_range(b, 0, b->frontier_size, &b->buffers[0])
+                    || gather(b);
+    }
+    b->done = b->failed || b->found || b->frontier_size == 0;
+}
+
+struct worker {
+    struct pbfs *b;
+    int id;
+};
+
+/*De lus van een thread: wacht op een level, breidt het eigen stuk van het
+frontier uit en wacht tot alle threads klaar zijn. Thread 0 voegt daarna de
+buffers samen en bepaalt of er nog een level komt.
+
+void *arg : een struct worker*/
+static void *worker_run(void *arg) {
+    struct worker *w = arg;
+    struct pbfs *b = w->b;
+
+    /* Wacht tot alle threads gestart zijn en de barriers klaar staan. */
+    pthread_mutex_lock(&b->gate_lock);
+    while (!b->gate) {
+        pthread_cond_wait(&b->gate_open, &b->gate_lock);
+    }
+    pthread_mutex_unlock(&b->gate_lock);
+
+    for (;;) {
+        pthread_barrier_wait(&b->level_start);
+        if (b->done) {
+            break;
+        }
+
+        size_t chunk = (b->frontier_size + (size_t)b->n_threads - 1)
+                       / (size_t)b->n_threads;
+        size_t lo = chunk * (size_t)w->id;
+        size_t hi = lo + chunk < b->frontier_size ? lo + chunk : b->frontier_size;
+        if (lo < hi && expand_range(b, lo, hi, &b->buffers[w->id]) != 0) {
+            __atomic_store_n(&b->failed, true, __ATOMIC_RELAXED);
+        }
+
+        pthread_barrier_wait(&b->level_end);
+        if (w->id == 0) {
+            if (!b->failed && gather(b) != 0) {
+                b->failed = true;
+            }
+            serial_levels(b);
+        }
+    }
+    return NULL;
+}
+
+/*Returned een integer die aangeeft of de toestand gemaakt is, 0 indien wel, 1 indien niet
+
+struct pbfs *b : de gedeelde toestand
+struct maze *m : pointer naar het doolhof
+int n_threads : het aantal threads*/
+static int pbfs_init(struct pbfs *b, struct maze *m, int n_threads) {
+    memset(b, 0, sizeof(struct pbfs));
+    b->m = m;
+    b->n_threads = n_threads;
+    b->visited = maze_visited(m);
+    b->blocked = malloc(maze_words(m) * sizeof(uint64_t));
+    b->pred = pred_init((size_t)maze_cells(m));
+    b->frontier = malloc(sizeof(int64_t));
+    if (!b->blocked || !b->pred || !b->frontier) {
+        return 1;
+    }
+
+    /* De muren en de rand, zodat de threads alleen een bit hoeven te testen. */
+    memcpy(b->blocked, maze_walls(m), maze_words(m) * sizeof(uint64_t));
+    int rows = maze_rows(m);
+    int cols = maze_cols(m);
+    for (int c = 0; c < cols; c++) {
+        bitset_set(b->blocked, (size_t)maze_index(m, 0, c));
+        bitset_set(b->blocked, (size_t)maze_index(m, rows - 1, c));
+    }
+    for (int r = 0; r < rows; r++) {
+        bitset_set(b->blocked, (size_t)maze_index(m, r, 0));
+        bitset_set(b->blocked, (size_t)maze_index(m, r, cols - 1));
+    }
+    for (int i = 0; i < N_MOVES; i++) {
+        b->step[i] = m_offsets[i][0] * maze_pitch(m) + m_offsets[i][1];
+    }
+
+    int r, c;
+    maze_destination(m, &r, &c);
+    b->dest_index = maze_index(m, r, c);
+    maze_start(m, &r, &c);
+    b->frontier[0] = maze_index(m, r, c);
+    b->frontier_size = 1;
+    bitset_set(b->visited, (size_t)b->frontier[0]);
+    b->found = b->frontier[0] == b->dest_index;
+    return 0;
+}
+
+/*struct pbfs *b : de gedeelde toestand
+
+Side effect: freed alles van 'b' behalve de visited bitset van het doolhof*/
+static void pbfs_cleanup(struct pbfs *b) {
+    free(b->blocked);
+    free(b->frontier);
+    pred_cleanup(b->pred);
+    for (int t = 0; t < MAX_THREADS; t++) {
+        free(b->buffers[t].cells);
+    }
+}
+
+/*Implementeert een parallelle level-synchrone bfs, deze returned hierbij de
+lengte van kortste pad.
+
+struct maze *m = een struct maze pointer naar m
+int n_threads = het aantal threads, inclusief de aanroepende thread
+
+side effects: de bezochte cellen en het pad worden gemarkeerd in m
+*/
+int pbfs_solve(struct maze *m, int n_threads) {
+    struct pbfs b;
+    if (pbfs_init(&b, m, n_threads) != 0) {
+        pbfs_cleanup(&b);
+        return ERROR;
+    }
+
+    serial_levels(&b);
+
+    /* Threads die niet gestart kunnen worden vallen af, de overige threads
+    verdelen het werk. Daarom worden de barriers pas na het starten gemaakt. */
+    struct worker workers[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    pthread_mutex_init(&b.gate_lock, NULL);
+    pthread_cond_init(&b.gate_open, NULL);
+    int started = 1;
+    workers[0].b = &b;
+    workers[0].id = 0;
+    for (; started < n_threads; started++) {
+        workers[started].b = &b;
+        workers[started].id = started;
+        if (pthread_create(&threads[started], NULL, worker_run,
+                           &workers[started]) != 0) {
+            break;
+        }
+    }
+
+    b.n_threads = started;
+    bool barriers = pthread_barrier_init(&b.level_start, NULL, (unsigned)started) == 0;
+    if (barriers && pthread_barrier_init(&b.level_end, NULL, (unsigned)started) != 0) {
+        pthread_barrier_destroy(&b.level_start);
+        barriers = false;
+    }
+    if (!barriers) {
+        /* Elke thread stopt dan meteen, een barrier voor een thread kan
+        altijd gemaakt worden en wacht nooit. */
+        b.failed = true;
+        b.done = true;
+        pthread_barrier_init(&b.level_start, NULL, 1);
+        pthread_barrier_init(&b.level_end, NULL, 1);
+    }
+
+    pthread_mutex_lock(&b.gate_lock);
+    b.gate = true;
+    pthread_cond_broadcast(&b.gate_open);
+    pthread_mutex_unlock(&b.gate_lock);
+
+    worker_run(&workers[0]);
+    for (int t = 1; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&b.level_start);
+    pthread_barrier_destroy(&b.level_end);
+    pthread_cond_destroy(&b.gate_open);
+    pthread_mutex_destroy(&b.gate_lock);
+
+    int length = NOT_FOUND;
+    if (b.failed) {
+        length = ERROR;
+    } else if (b.found) {
+        length = pred_backtrack(m, b.pred);
+    }
+    pbfs_cleanup(&b);
+    return length;
+}
+
+int main(int argc, char *argv[]) {
+    struct output output = { true, 0 };
+    int option;
+    while ((option = getopt(argc, argv, OUTPUT_OPTIONS)) != -1) {
+        if (!output_option(&output, option, optarg)) {
+            optind = argc + 1;
+            break;
+        }
+    }
+    long n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (optind == argc - 1) {
+        n_threads = strtol(argv[optind], NULL, 10);
+    }
+    if (optind > argc || argc - optind > 1 || n_threads < 1
+        || n_threads > MAX_THREADS) {
+        printf("Usage: %s " OUTPUT_USAGE " [threads (1 - %d)]\n", argv[0],
+               MAX_THREADS);
+        return 1;
+    }
+
+    /* read maze */
+    struct maze *m = maze_read();
+    if (!m) {
+        printf("Error reading maze\n");
+        return 1;
+    }
+
+    /* solve maze */
+    double start = timer_ms();
+    int path_length = pbfs_solve(m, (int)n_threads);
+    double elapsed = timer_ms() - start;
+    fprintf(stderr, "pbfs visited %zu cells in %.3f ms with %ld threads\n",
+            maze_count_visited(m), elapsed, n_threads);
+    if (path_length == ERROR) {
+        printf("pbfs failed\n");
+        maze_cleanup(m);
+        return 1;
+    } else if (path_length == NOT_FOUND) {
+        printf("no path found from start to destination\n");
+        maze_cleanup(m);
+        return 1;
+    }
+    printf("pbfs found a path of length: %d\n", path_length);
+
+    /* print maze */
+    output_maze(m, &output);
+    maze_cleanup(m);
+    return 0;
+}
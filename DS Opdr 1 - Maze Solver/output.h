@@ -0,0 +1,91 @@
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "maze.h"
+#include "timer.h"
+
+/* Output options of the solvers
+ * A solver prints the solved maze to stdout and writes it to out.ppm. On a
+ * large maze that takes longer than the search itself, so every solver
+ * takes the options:
+ *   -q       do not print the maze, only the path length
+ *   -r size  render out.ppm at most 'size' by 'size' pixels
+ * A solver with options of its own adds OUTPUT_OPTIONS to its getopt()
+ * option string and passes every option to output_option(). Needs
+ * _POSIX_C_SOURCE 200809L or later for getopt(). */
+#define OUTPUT_OPTIONS "qr:"
+#define OUTPUT_USAGE "[-q] [-r size]"
+
+struct output {
+    bool print;
+    int ppm_size;
+};
+
+/* Returns the image size in 'arg', or -1 if it is not a positive number. */
+static inline int output_size(const char *arg) {
+    char *end;
+    long size = strtol(arg, &end, 10);
+    if (*arg == '\0' || *end != '\0' || size < 1 || size > INT_MAX) {
+        return -1;
+    }
+    return (int)size;
+}
+
+/* Handles 'option' with argument 'arg' from getopt().
+ * Returns true if it is one of OUTPUT_OPTIONS with a valid argument. */
+static inline bool output_option(struct output *o, int option, const char *arg) {
+    if (option == 'q') {
+        o->print = false;
+        return true;
+    } else if (option == 'r') {
+        o->ppm_size = output_size(arg);
+        return o->ppm_size > 0;
+    }
+    return false;
+}
+
+/* Sets 'o' from the options of a solver without options of its own.
+ * Returns 0 if all arguments are valid output options, 1 otherwise. */
+static inline int output_options(struct output *o, int argc, char *argv[]) {
+    o->print = true;
+    o->ppm_size = 0;
+    int option;
+    while ((option = getopt(argc, argv, OUTPUT_OPTIONS)) != -1) {
+        if (!output_option(o, option, optarg)) {
+            return 1;
+        }
+    }
+    return optind != argc;
+}
+
+/* Checks with the components of 'm' if there is a path at all, for the -c
+ * option of solver 'name'. The labels stay with the maze, so an impossible
+ * maze fails at once instead of after searching the whole component of the
+ * start. The time spent labeling is printed to stderr.
+ * Returns 1 if a path connects the start and the destination, 0 if not and
+ * -1 if the components could not be labeled. */
+static inline int output_precheck(struct maze *m, const char *name) {
+    double start = timer_ms();
+    int reachable = maze_reachable(m);
+    if (reachable >= 0) {
+        fprintf(stderr, "%s labeled %u components in %.3f ms\n", name,
+                maze_n_components(m), timer_ms() - start);
+    }
+    return reachable;
+}
+
+/* Prints maze 'm' unless -q was given and writes it to out.ppm. */
+static inline void output_maze(const struct maze *m, const struct output *o) {
+    if (o->print) {
+        maze_print(m, false);
+    }
+    maze_output_ppm_scaled(m, "out.ppm", o->ppm_size);
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "pred.h"
+
+#define MOVES_PER_BYTE 4
+
+struct pred {
+    size_t cells;
+    uint8_t moves[];
+};
+
+/* Returns the number of bytes holding the moves of 'cells' cells. */
+static size_t pred_bytes(size_t cells) {
+    return (cells + MOVES_PER_BYTE - 1) / MOVES_PER_BYTE;
+}
+
+struct pred *pred_init(size_t cells) {
+    struct pred *p = calloc(1, sizeof(struct pred) + pred_bytes(cells));
+    if (p == NULL) {
+        return NULL;
+    }
+    p->cells = cells;
+    return p;
+}
+
+void pred_cleanup(struct pred *p) {
+    free(p);
+}
+
+int pred_save(const struct pred *p, FILE *fp) {
+    size_t bytes = pred_bytes(p->cells);
+    return fwrite(p->moves, 1, bytes, fp) != bytes;
+}
+
+struct pred *pred_load(FILE *fp, size_t cells) {
+    struct pred *p = pred_init(cells);
+    size_t bytes = pred_bytes(cells);
+    if (p != NULL && fread(p->moves, 1, bytes, fp) != bytes) {
+        pred_cleanup(p);
+        return NULL;
+    }
+    return p;
+}
+
+void pred_set(struct pred *p, size_t index, int move) {
+    unsigned shift = (unsigned)(index % MOVES_PER_BYTE) * 2;
+    uint8_t byte = p->moves[index / MOVES_PER_BYTE];
+    byte = (uint8_t)((byte & ~(3u << shift)) | ((unsigned)move & 3u) << shift);
+    p->moves[index / MOVES_PER_BYTE] = byte;
+}
+
+void pred_set_atomic(struct pred *p, size_t index, int move) {
+    unsigned shift = (unsigned)(index % MOVES_PER_BYTE) * 2;
+    __atomic_fetch_or(&p->moves[index / MOVES_PER_BYTE],
+                      (uint8_t)(((unsigned)move & 3u) << shift), __ATOMIC_RELAXED);
+}
+
+int pred_get(const struct pred *p, size_t index) {
+    unsigned shift = (unsigned)(index % MOVES_PER_BYTE) * 2;
+    return (p->moves[index / MOVES_PER_BYTE] >> shift) & 3;
+}
+
+int64_t pred_from(const struct maze *m, const struct pred *p, int64_t index) {
+    /* Moves are numbered clockwise, so the opposite move is two further. */
+    int back = (pred_get(p, (size_t)index) + 2) % N_MOVES;
+    return maze_neighbour(m, index, back);
+}
+
+int pred_mark_path(struct maze *m, const struct pred *p, int64_t index,
+                   int64_t stop_index) {
+    int length = 0;
+    while (index != stop_index) {
+        maze_set(m, maze_row(m, index), maze_col(m, index), PATH);
+        index = pred_from(m, p, index);
+        length++;
+    }
+    return length;
+}
+
+int pred_backtrack(struct maze *m, const struct pred *p) {
+    int r, c;
+    maze_start(m, &r, &c);
+    int64_t start_index = maze_index(m, r, c);
+    maze_destination(m, &r, &c);
+    return pred_mark_path(m, p, maze_index(m, r, c), start_index);
+}
@@ -0,0 +1,56 @@
+#ifndef _PRED_H_
+#define _PRED_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "maze.h"
+
+/* Predecessor store interface
+ * Stores for every cell the move (an index into m_offsets) that led into
+ * it during a search, using 2 bits per cell in a single allocation. */
+
+/* Handle to predecessor store */
+struct pred;
+
+/* Return a pointer to a predecessor store for 'cells' cells if successful,
+ * otherwise return NULL. */
+struct pred *pred_init(size_t cells);
+
+/* Cleanup predecessor store. */
+void pred_cleanup(struct pred *p);
+
+/* Write the stored moves to 'fp' in the 2 bits per cell layout.
+ * Return 0 if successful, 1 otherwise. */
+int pred_save(const struct pred *p, FILE *fp);
+
+/* Return a predecessor store for 'cells' cells read from 'fp', as written
+ * by pred_save(), or NULL if an error occured. */
+struct pred *pred_load(FILE *fp, size_t cells);
+
+/* Record that cell 'index' was reached with move 'move'. */
+void pred_set(struct pred *p, size_t index, int move);
+
+/* Like pred_set(), but safe to call from several threads at once for
+ * different cells. Every cell may be set at most once after pred_init(),
+ * because the move is ORed into the zeroed store. */
+void pred_set_atomic(struct pred *p, size_t index, int move);
+
+/* Return the move that led into cell 'index'. */
+int pred_get(const struct pred *p, size_t index);
+
+/* Return the index of the cell that cell 'index' was reached from. */
+int64_t pred_from(const struct maze *m, const struct pred *p, int64_t index);
+
+/* Marks the cells from 'index' back to (but not including) 'stop_index' as
+ * PATH by walking the recorded moves back from 'index'.
+ * Return the number of marked cells. */
+int pred_mark_path(struct maze *m, const struct pred *p, int64_t index,
+                   int64_t stop_index);
+
+/* Marks the path from the start to the destination of 'm' as PATH by
+ * walking the recorded moves back from the destination.
+ * Return the length of the path. */
+int pred_backtrack(struct maze *m, const struct pred *p);
+
+#endif
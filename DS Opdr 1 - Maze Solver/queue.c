@@ -1,27 +1,33 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "queue.h"
 
+/* Ring buffer met een capaciteit die altijd een macht van twee is, zodat
+de posities met een masker (capaciteit - 1) berekend worden in plaats van
+met een modulo. */
 struct queue {
-    int *queue_data;
+    int64_t *queue_data;
     size_t queue_capacity;
-    size_t current_size;
+    size_t head;
     size_t pop_count;
     size_t push_count;
-    int max_elements;
+    size_t max_elements;
 };
 
 /*Initialiseert een pointer naar een struct van type queue, en alloceert plek op de heap
 voor de struct queue en de queue_data array.
 
-size_t capacity : grote van de queue_data array binnen de gealloceerde
-queue.
+size_t capacity : begin grote van de queue_data array binnen de gealloceerde
+queue, afgerond naar boven op een macht van twee. De queue groeit
+automatisch als deze vol is.
 
 Side effect : Initialiseert waarden binnen de struct queue.*/
 struct queue *queue_init(size_t capacity) {
-    if (capacity <= 0) {
-        return NULL;
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
     }
 
     struct queue *q = malloc(sizeof(struct queue));
@@ -29,13 +35,14 @@ struct queue *queue_init(size_t capacity) {
         return NULL;
     }
 
-    q->queue_data = malloc(sizeof(int) * capacity);
+    q->queue_data = malloc(sizeof(int64_t) * rounded);
     if (q->queue_data == NULL) {
-        free(q); 
+        free(q);
         return NULL;
     }
 
-    q->queue_capacity = capacity;
+    q->queue_capacity = rounded;
+    q->head = 0;
     q->max_elements = 0;
     q->pop_count = 0;
     q->push_count = 0;
@@ -61,30 +68,52 @@ void queue_stats(const struct queue *q) {
     if (q == NULL) {
         return;
     }
-    fprintf(stderr, "stats %zu %zu %d\n",
+    fprintf(stderr, "stats %zu %zu %zu\n",
         q->push_count, q->pop_count, q->max_elements);
 }
 
+/*Returned 0 als de queue_data array succesvol verdubbeld is, 1 indien niet.
+
+struct queue *q : pointer naar de volle queue struct op de heap
+
+Side effect: de elementen voor head (het omgeslagen deel van de ring) worden
+achter de oude elementen geplaatst, zodat ze weer op volgorde liggen. Elk
+element wordt zo per verdubbeling hooguit een keer gekopieerd.*/
+static int queue_grow(struct queue *q) {
+    size_t old_capacity = q->queue_capacity;
+    int64_t *tmp = realloc(q->queue_data, sizeof(int64_t) * old_capacity * 2);
+    if (tmp == NULL) {
+        return 1;
+    }
+
+    memcpy(tmp + old_capacity, tmp, sizeof(int64_t) * q->head);
+    q->queue_data = tmp;
+    q->queue_capacity = old_capacity * 2;
+    return 0;
+}
+
 /*Returned een integer die aangeeft of een integer succesvol gepushed is, 1 indien niet, 0 indien wel
 
 struct queue *s : pointer naar de queue struct op de heap
-int c : de integer die gepushed wordt op de queue
+int64_t c : de integer die gepushed wordt op de queue
 
-Side effect: pushed een integer op de queue*/
-int queue_push(struct queue *q, int e) {
+Side effect: pushed een integer op de queue, de queue groeit als deze vol is*/
+int queue_push(struct queue *q, int64_t e) {
     if (q == NULL) {
         return 1;
     }
 
-    if (q->queue_capacity != queue_size(q)) {
-        q->queue_data[q->push_count++ % q->queue_capacity] = e;
-        if ((int)queue_size(q) > q->max_elements) {
-            q->max_elements = (int)queue_size(q);
-        }
-        return 0;
-    } else {
+    if (queue_size(q) == q->queue_capacity && queue_grow(q) != 0) {
         return 1;
     }
+
+    size_t mask = q->queue_capacity - 1;
+    q->queue_data[(q->head + queue_size(q)) & mask] = e;
+    q->push_count++;
+    if (queue_size(q) > q->max_elements) {
+        q->max_elements = queue_size(q);
+    }
+    return 0;
 }
 
 /*Returned een integer die aangeeft of een integer succesvol gepopped is, of de gepoppte integer zelf
@@ -92,11 +121,14 @@ int queue_push(struct queue *q, int e) {
 struct queue *s : pointer naar de queue struct op de heap
 
 side effect: een integer wordt gepopped van de queue*/
-int queue_pop(struct queue *q) {
+int64_t queue_pop(struct queue *q) {
     if (q == NULL || queue_size(q) <= 0) {
         return -1;
     }
-    return q->queue_data[q->pop_count++ % q->queue_capacity];
+    int64_t e = q->queue_data[q->head];
+    q->head = (q->head + 1) & (q->queue_capacity - 1);
+    q->pop_count++;
+    return e;
 }
 
 /*Returned de integer op de top van de queue, of -1 indien dit niet gelukt is
@@ -104,13 +136,13 @@ int queue_pop(struct queue *q) {
 const struct queue *s : pointer naar de queue struct op de heap
 
 */
-int queue_peek(const struct queue *q) {
+int64_t queue_peek(const struct queue *q) {
     if (q == NULL) {
         return -1;
     } else if (queue_size(q) <= 0) {
         return 1;
     }
-    return q->queue_data[q->pop_count % q->queue_capacity];
+    return q->queue_data[q->head];
 }
 
 /*Returned een -1 indien de struct pointer NULL is, 1 als de queue leeg is, 0 als de queue elementen bevat
@@ -126,6 +158,17 @@ int queue_empty(const struct queue *q) {
     }
 }
 
+/*struct queue *q : pointer naar de queue struct op de heap
+
+Side effect: alle elementen worden gepopped, de queue_data array blijft even
+groot*/
+void queue_clear(struct queue *q) {
+    if (q == NULL) {
+        return;
+    }
+    q->pop_count = q->push_count;
+}
+
 /*Returned een -1 indien de struct pointer NULL is, 1 als de queue leeg is, 0 als de queue elementen bevat
 
 struct queue *s : pointer naar de queue struct op de heap*/
@@ -3,42 +3,62 @@
 
 #include "stack.h"
 
-#define EMPTY -1
+/* Een blok van de stack. Als een blok vol is wordt er een nieuw blok van
+twee keer de grote aan gekoppeld, zodat bestaande elementen bij het groeien
+nooit gekopieerd hoeven te worden. */
+struct stack_chunk {
+    struct stack_chunk *prev;
+    size_t capacity;
+    size_t used;
+    int64_t data[];
+};
 
 typedef struct stack {
-    int *stack_data;
-    size_t stack_capacity;
-    int stack_top;
-    int pop_count;
-    int push_count;
-    int max_elements;
+    struct stack_chunk *top;
+    struct stack_chunk *spare;
+    size_t size;
+    size_t pop_count;
+    size_t push_count;
+    size_t max_elements;
 } stack_t;
 
+/*Returned een pointer naar een nieuw leeg blok voor 'capacity' elementen, of
+NULL als dat niet gelukt is.
+
+struct stack_chunk *prev : het blok onder het nieuwe blok, of NULL*/
+static struct stack_chunk *chunk_init(struct stack_chunk *prev, size_t capacity) {
+    struct stack_chunk *chunk = malloc(sizeof(struct stack_chunk)
+                                       + capacity * sizeof(int64_t));
+    if (chunk == NULL) {
+        return NULL;
+    }
+    chunk->prev = prev;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    return chunk;
+}
+
 /*Initialiseert een pointer naar een struct van type stack, en alloceert plek op de heap
-voor de struct stack en de stack_data array.
+voor de struct stack en het eerste blok van de stack.
 
-size_t capacity : grote van de stack_data array binnen de gealloceerde
-stack.
+size_t capacity : grote van het eerste blok binnen de gealloceerde
+stack. De stack groeit automatisch als deze vol is.
 
 Side effect : Initialiseert waarden binnen de struct stack.*/
 struct stack *stack_init(size_t capacity) {
-    if (capacity <= 0) {
-        return NULL;
-    }
-
     stack_t *s = (stack_t *)malloc(sizeof(stack_t));
     if (s == NULL) {
         return NULL;
     }
 
-    s->stack_data = (int *)malloc(capacity * sizeof(size_t));
-    if (s->stack_data == NULL) {
+    s->top = chunk_init(NULL, capacity > 0 ? capacity : 1);
+    if (s->top == NULL) {
         free(s);
         return NULL;
     }
 
-    s->stack_top = EMPTY;
-    s->stack_capacity = capacity;
+    s->spare = NULL;
+    s->size = 0;
     s->pop_count = 0;
     s->push_count = 0;
     s->max_elements = 0;
@@ -48,12 +68,17 @@ struct stack *stack_init(size_t capacity) {
 
 /*struct stack *s : pointer naar de stack struct op de heap
 
-Side effect: Freed de stack_data array en de struct stack op de heap.*/
+Side effect: Freed alle blokken van de stack en de struct stack op de heap.*/
 void stack_cleanup(struct stack *s) {
     if (s == NULL) {
         return;
     }
-    free(s->stack_data);
+    while (s->top != NULL) {
+        struct stack_chunk *prev = s->top->prev;
+        free(s->top);
+        s->top = prev;
+    }
+    free(s->spare);
     free(s);
 }
 
@@ -64,46 +89,52 @@ void stack_stats(const struct stack *s) {
     if (s == NULL) {
         return;
     }
-    fprintf(stderr, "stats %d %d %d\n", s->push_count, s->pop_count, s->max_elements);
+    fprintf(stderr, "stats %zu %zu %zu\n", s->push_count, s->pop_count, s->max_elements);
 }
 
-/*Returned een integer die aangeeft of de stack_data array succesvol is vergroot, 0 indien niet, 1 indien wel;
+/*Returned een integer die aangeeft of er een nieuw blok op de stack is gezet, 0 indien niet, 1 indien wel;
 
 struct stack *s : pointer naar de stack struct op de heap
 
-Side effect: Vergroot de size of de stack_data array op de*/
-int resize_stack(struct stack *s) {
-    int *tmp;
-    tmp = (int*)realloc(s->stack_data, (s->stack_capacity * 2 + 1) * sizeof(int));
-    s->stack_capacity = ((s->stack_capacity * 2 + 1));
-    if (tmp == NULL) {
-        return 0;
+Side effect: hergebruikt het reserve blok of koppelt een nieuw blok van
+twee keer de grote van het bovenste blok aan de stack*/
+static int push_chunk(struct stack *s) {
+    struct stack_chunk *chunk = s->spare;
+    if (chunk != NULL) {
+        s->spare = NULL;
+        chunk->prev = s->top;
+        chunk->used = 0;
+    } else {
+        chunk = chunk_init(s->top, s->top->capacity * 2);
+        if (chunk == NULL) {
+            return 0;
+        }
     }
-    s->stack_data = tmp;
+    s->top = chunk;
     return 1;
 }
 
 /*Returned een integer die aangeeft of een integer succesvol gepushed is, 1 indien niet, 0 indien wel
 
 struct stack *s : pointer naar de stack struct op de heap
-int c : de integer die gepushed wordt op de stack
+int64_t c : de integer die gepushed wordt op de stack
 
 Side effect: pushed een integer op de stack*/
-int stack_push(struct stack *s, int c) {
+int stack_push(struct stack *s, int64_t c) {
     if (stack_empty(s) == -1) {
         return 1;
     }
 
-    s->stack_top++;
-    if (s->stack_top >= (int)s->stack_capacity) {
-        resize_stack(s);
+    if (s->top->used == s->top->capacity && !push_chunk(s)) {
+        return 1;
     }
 
-    if ((int)stack_size(s) > s->max_elements) {
-        s->max_elements = (int)stack_size(s);
-    }
+    s->top->data[s->top->used++] = c;
+    s->size++;
     s->push_count++;
-    s->stack_data[s->stack_top] = c;
+    if (s->size > s->max_elements) {
+        s->max_elements = s->size;
+    }
     return 0;
 }
 
@@ -111,15 +142,24 @@ int stack_push(struct stack *s, int c) {
 
 struct stack *s : pointer naar de stack struct op de heap
 
-side effect: een integer wordt gepopped van de stack*/
-int stack_pop(struct stack *s) {
+side effect: een integer wordt gepopped van de stack, een leeg geraakt blok
+wordt als reserve bewaard zodat heen en weer pushen en poppen rond een
+blokgrens geen mallocs kost*/
+int64_t stack_pop(struct stack *s) {
     if (stack_empty(s) == 1 || stack_empty(s) == -1) {
         return -1;
     }
 
-    s->stack_top--;
+    if (s->top->used == 0) {
+        struct stack_chunk *empty = s->top;
+        s->top = empty->prev;
+        free(s->spare);
+        s->spare = empty;
+    }
+
+    s->size--;
     s->pop_count++;
-    return s->stack_data[s->stack_top + 1];
+    return s->top->data[--s->top->used];
 }
 
 /*Returned de integer op de top van de stack, of -1 indien dit niet gelukt
@@ -127,12 +167,13 @@ int stack_pop(struct stack *s) {
 const struct stack *s : pointer naar de stack struct op de heap
 
 */
-int stack_peek(const struct stack *s) {
-    if (stack_empty(s) == -1) {
+int64_t stack_peek(const struct stack *s) {
+    if (stack_empty(s) != 0) {
         return -1;
     }
 
-    return s->stack_data[s->stack_top];
+    const struct stack_chunk *chunk = s->top->used ? s->top : s->top->prev;
+    return chunk->data[chunk->used - 1];
 }
 
 /*Returned een -1 indien de struct pointer NULL is, 1 als de stack leeg is, 0 als de stack elementen bevat
@@ -141,7 +182,7 @@ struct stack *s : pointer naar de stack struct op de heap*/
 int stack_empty(const struct stack *s) {
     if (s == NULL) {
         return -1;
-    } else if (s->stack_top == EMPTY) {
+    } else if (s->size == 0) {
         return 1;
     } else {
         return 0;
@@ -156,5 +197,5 @@ size_t stack_size(const struct stack *s) {
     if (s == NULL) {
         return 0;
     }
-    return (size_t)s->stack_top + 1;
+    return s->size;
 }
@@ -1,11 +1,13 @@
-/* Do not edit this file. */
 #include <stddef.h>
+#include <stdint.h>
 
-/* Handle to stack */
+/* Handle to stack, the items are 64-bit integers so that every cell index
+ * of a large maze fits. */
 struct stack;
 
-/* Return a pointer to a stack data structure with a maximum capacity of
- * 'capacity' if successful, otherwise return NULL. */
+/* Return a pointer to a stack data structure with an initial capacity of
+ * 'capacity' if successful, otherwise return NULL. The stack grows when it is
+ * full, a capacity of 0 is allowed. */
 struct stack *stack_init(size_t capacity);
 
 /* Cleanup stack. */
@@ -17,15 +19,15 @@ void stack_stats(const struct stack *s);
 
 /* Push item onto the stack.
  * Return 0 if successful, 1 otherwise. */
-int stack_push(struct stack *s, int e);
+int stack_push(struct stack *s, int64_t e);
 
 /* Pop item from stack and return it.
  * Return top item if successful, -1 otherwise. */
-int stack_pop(struct stack *s);
+int64_t stack_pop(struct stack *s);
 
 /* Return top of item from stack. Leave stack unchanged.
  * Return top item if successful, -1 otherwise. */
-int stack_peek(const struct stack *s);
+int64_t stack_peek(const struct stack *s);
 
 /* Return 1 if stack is empty, 0 if the stack contains any elements and
  * return -1 if the operation fails. */
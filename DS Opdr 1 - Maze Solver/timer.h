@@ -0,0 +1,14 @@
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#include <time.h>
+
+/* Returns a monotonic time stamp in milliseconds, for timing the solvers.
+ * Needs _POSIX_C_SOURCE 199309L or later for clock_gettime(). */
+static inline double timer_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+#endif
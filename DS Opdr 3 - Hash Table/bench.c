@@ -0,0 +1,332 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+This program benchmarks the word index. The words of a text file are read
+into memory once, so only the hash tables themselves are timed. Every
+configuration is built and queried several times after a warmup, the
+timings are taken with a monotonic clock and summarized as CSV.*/
+
+// Needed for clock_gettime()
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "hash_func.h"
+#include "hash_table.h"
+#include "word_index.h"
+
+#define START_TESTS 3
+#define MAX_TESTS 4
+#define HASH_TESTS 3
+#define BACKENDS 3
+
+/* All words of a text file in reading order. 'text' holds the words
+ * separated by '\0', 'offsets' the start of every word in 'text'. */
+struct corpus {
+    char *text;
+    size_t text_size;
+    size_t text_capacity;
+    size_t *offsets;
+    int *lines;
+    size_t count;
+    size_t capacity;
+};
+
+/* A word index implementation. Backends with a 'fixed_hash' have their
+ * hash function compiled in and ignore the 'hash_func' argument, backends
+ * that 'ignores_load' have no load factor and ignore 'max_load'. Both are
+ * benchmarked once instead of for every hash function or load factor. */
+struct backend {
+    const char *name;
+    const char *fixed_hash;
+    int ignores_load;
+    void *(*build)(const struct corpus *c, unsigned long start_size,
+                   double max_load,
+                   unsigned long (*hash_func)(const unsigned char *));
+    unsigned long (*lookup)(const void *table, const struct corpus *c);
+    void (*cleanup)(void *table);
+};
+
+/* Keeps the lookup results alive so the lookups are not optimized away. */
+static volatile unsigned long bench_sink;
+
+/* Returns the time of a monotonic clock in microseconds. */
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+/* Appends 'word' on 'line_number' to the corpus 'ctx'.
+ * Returns 0 if successful and 1 otherwise. */
+static int corpus_add(void *ctx, char *word, int line_number) {
+    struct corpus *c = ctx;
+    size_t len = strlen(word) + 1;
+
+    if (c->text_size + len > c->text_capacity) {
+        size_t capacity = c->text_capacity ? c->text_capacity * 2 : 4096;
+        while (c->text_size + len > capacity) {
+            capacity *= 2;
+        }
+        char *tmp = realloc(c->text, capacity);
+        if (tmp == NULL) {
+            return 1;
+        }
+        c->text = tmp;
+        c->text_capacity = capacity;
+    }
+
+    if (c->count == c->capacity) {
+        size_t capacity = c->capacity ? c->capacity * 2 : 1024;
+        size_t *offsets = realloc(c->offsets, capacity * sizeof(size_t));
+        if (offsets == NULL) {
+            return 1;
+        }
+        c->offsets = offsets;
+        int *lines = realloc(c->lines, capacity * sizeof(int));
+        if (lines == NULL) {
+            return 1;
+        }
+        c->lines = lines;
+        c->capacity = capacity;
+    }
+
+    memcpy(c->text + c->text_size, word, len);
+    c->offsets[c->count] = c->text_size;
+    c->lines[c->count] = line_number;
+    c->text_size += len;
+    c->count++;
+    return 0;
+}
+
+static void corpus_cleanup(struct corpus *c) {
+    free(c->text);
+    free(c->offsets);
+    free(c->lines);
+}
+
+static char *corpus_word(const struct corpus *c, size_t i) {
+    return c->text + c->offsets[i];
+}
+
+static void *legacy_build(const struct corpus *c, unsigned long start_size,
+                          double max_load,
+                          unsigned long (*hash_func)(const unsigned char *)) {
+    struct table *t = table_init(start_size, max_load, hash_func);
+    if (t == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < c->count; i++) {
+        if (table_insert(t, corpus_word(c, i), c->lines[i]) != 0) {
+            table_cleanup(t);
+            return NULL;
+        }
+    }
+    return t;
+}
+
+static unsigned long legacy_lookup(const void *table, const struct corpus *c) {
+    unsigned long found = 0;
+    for (size_t i = 0; i < c->count; i++) {
+        found += array_size(table_lookup(table, corpus_word(c, i)));
+    }
+    return found;
+}
+
+static void legacy_cleanup(void *table) {
+    table_cleanup(table);
+}
+
+static void *generic_build(const struct corpus *c, unsigned long start_size,
+                           double max_load,
+                           unsigned long (*hash_func)(const unsigned char *)) {
+    (void)hash_func;
+    struct word_table *t = word_table_init(start_size, max_load);
+    if (t == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < c->count; i++) {
+        if (word_table_add(t, corpus_word(c, i), c->lines[i]) != 0) {
+            word_table_cleanup(t);
+            return NULL;
+        }
+    }
+    return t;
+}
+
+static unsigned long generic_lookup(const void *table, const struct corpus *c) {
+    unsigned long found = 0;
+    for (size_t i = 0; i < c->count; i++) {
+        struct array **lines = word_table_lookup(table, corpus_word(c, i));
+        found += lines == NULL ? 0 : array_size(*lines);
+    }
+    return found;
+}
+
+static void generic_cleanup(void *table) {
+    word_table_cleanup(table);
+}
+
+/* The interned backend owns its pool, unlike a regular interned index. Its
+ * lines are indexed by id, so only the pool is hashed and there is no load
+ * factor to set. */
+static void *interned_build(const struct corpus *c, unsigned long start_size,
+                            double max_load,
+                            unsigned long (*hash_func)(const unsigned char *)) {
+    (void)max_load;
+    (void)hash_func;
+    struct intern_pool *pool = intern_init(start_size);
+    struct interned_index *index = interned_index_init(pool, start_size);
+    if (index == NULL) {
+        intern_cleanup(pool);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < c->count; i++) {
+        if (interned_index_add(index, corpus_word(c, i), c->lines[i]) != 0) {
+            intern_cleanup(index->pool);
+            interned_index_cleanup(index);
+            return NULL;
+        }
+    }
+    return index;
+}
+
+static unsigned long interned_lookup(const void *table,
+                                     const struct corpus *c) {
+    unsigned long found = 0;
+    for (size_t i = 0; i < c->count; i++) {
+        found += array_size(interned_index_lookup(table, corpus_word(c, i)));
+    }
+    return found;
+}
+
+static void interned_cleanup(void *table) {
+    struct interned_index *index = table;
+    intern_cleanup(index->pool);
+    interned_index_cleanup(index);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorts the 'n' samples and prints them as the last CSV columns. */
+static void print_stats(double *samples, int n, size_t ops) {
+    qsort(samples, (size_t)n, sizeof(double), compare_double);
+
+    double median = n % 2 ? samples[n / 2]
+                          : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    /* Nearest rank percentile. */
+    int p99_rank = (int)ceil(0.99 * n) - 1;
+    double p99 = samples[p99_rank < 0 ? 0 : p99_rank];
+
+    printf("%d,%zu,%.1f,%.1f,%.1f,%.2f\n", n, ops, median, p99, samples[0],
+           ops ? median * 1e3 / (double)ops : 0.0);
+}
+
+/* Benchmarks one configuration. Returns 0 if successful and 1 otherwise. */
+static int bench_config(const struct corpus *c, const struct backend *b,
+                        const char *hash_name, unsigned long start_size,
+                        double max_load,
+                        unsigned long (*hash_func)(const unsigned char *),
+                        int runs, int warmup) {
+    double *build_us = malloc((size_t)runs * sizeof(double));
+    double *lookup_us = malloc((size_t)runs * sizeof(double));
+    if (!build_us || !lookup_us) {
+        free(build_us);
+        free(lookup_us);
+        return 1;
+    }
+
+    for (int r = 0; r < warmup + runs; r++) {
+        double start = now_us();
+        void *table = b->build(c, start_size, max_load, hash_func);
+        double built = now_us();
+        if (table == NULL) {
+            free(build_us);
+            free(lookup_us);
+            return 1;
+        }
+        bench_sink = b->lookup(table, c);
+        double end = now_us();
+        b->cleanup(table);
+
+        if (r >= warmup) {
+            build_us[r - warmup] = built - start;
+            lookup_us[r - warmup] = end - built;
+        }
+    }
+
+    /* The load factor column stays empty if the backend has none. */
+    char load[32] = "";
+    if (!b->ignores_load) {
+        snprintf(load, sizeof(load), "%.2f", max_load);
+    }
+    printf("%s,%s,%lu,%s,build,", b->name, hash_name, start_size, load);
+    print_stats(build_us, runs, c->count);
+    printf("%s,%s,%lu,%s,lookup,", b->name, hash_name, start_size, load);
+    print_stats(lookup_us, runs, c->count);
+
+    free(build_us);
+    free(lookup_us);
+    return 0;
+}
+
+int bench_run(char *filename, int runs, int warmup) {
+    if (runs <= 0 || warmup < 0) {
+        return 1;
+    }
+
+    struct corpus c = { 0 };
+    if (for_each_word(filename, corpus_add, &c) != 0) {
+        corpus_cleanup(&c);
+        return 1;
+    }
+
+    unsigned long start_sizes[START_TESTS] = { 2, 1024, 65536 };
+    double max_loads[MAX_TESTS] = { 0.25, 0.5, 1.0, 2.0 };
+    unsigned long (*hash_funcs[HASH_TESTS])(const unsigned char *) = {
+        hash_too_simple, hash_djb2, hash_k_and_r_v2 };
+    const char *hash_names[HASH_TESTS] = { "too_simple", "djb2", "k_and_r_v2" };
+    const struct backend backends[BACKENDS] = {
+        { "chaining", NULL, 0, legacy_build, legacy_lookup, legacy_cleanup },
+        { "generic", "djb2", 0, generic_build, generic_lookup,
+          generic_cleanup },
+        { "interned", "djb2", 1, interned_build, interned_lookup,
+          interned_cleanup },
+    };
+
+    printf("backend,hash,start_size,max_load,phase,runs,ops,"
+           "median_us,p99_us,min_us,median_ns_per_op\n");
+
+    for (int b = 0; b < BACKENDS; b++) {
+        int hash_tests = backends[b].fixed_hash ? 1 : HASH_TESTS;
+        int load_tests = backends[b].ignores_load ? 1 : MAX_TESTS;
+        for (int k = 0; k < hash_tests; k++) {
+            const char *hash_name = backends[b].fixed_hash ?
+                                    backends[b].fixed_hash : hash_names[k];
+            for (int i = 0; i < START_TESTS; i++) {
+                for (int j = 0; j < load_tests; j++) {
+                    if (bench_config(&c, &backends[b], hash_name,
+                                     start_sizes[i], max_loads[j],
+                                     hash_funcs[k], runs, warmup) != 0) {
+                        corpus_cleanup(&c);
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    corpus_cleanup(&c);
+    return 0;
+}
@@ -0,0 +1,19 @@
+/* Benchmark interface
+ * Compares hash table backends, hash functions, start sizes and load
+ * factors on the words of a text file. */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/* Default number of measured runs and untimed warmup runs per
+ * configuration. */
+#define BENCH_RUNS 5
+#define BENCH_WARMUP 1
+
+/* Indexes the words of 'filename' with every benchmark configuration,
+ * 'warmup' untimed times followed by 'runs' timed times, and prints the
+ * median, p99 and minimum time of the build and the lookup phase as CSV
+ * on stdout. Returns 0 if successful and 1 otherwise. */
+int bench_run(char *filename, int runs, int warmup);
+
+#endif
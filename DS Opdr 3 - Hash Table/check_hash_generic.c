@@ -0,0 +1,176 @@
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hash_table_generic.h"
+
+// For older versions of the check library
+#ifndef ck_assert_ptr_nonnull
+#define ck_assert_ptr_nonnull(X) _ck_assert_ptr(X, !=, NULL)
+#endif
+#ifndef ck_assert_ptr_null
+#define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
+#endif
+
+struct point {
+    int x;
+    int y;
+};
+
+HASH_TABLE_DEFINE(id_table, unsigned long, struct point, ht_ulong_hash,
+                  ht_ulong_eq, HT_COPY_PLAIN, HT_FREE_NONE, HT_FREE_NONE)
+
+HASH_TABLE_DEFINE(str_table, char *, int, ht_str_hash, ht_str_eq,
+                  ht_str_copy, ht_str_free, HT_FREE_NONE)
+
+/* Tests */
+
+/* test init/cleanup */
+START_TEST(test_init) {
+    struct id_table *t = id_table_init(3, 0.75);
+    ck_assert_ptr_nonnull(t);
+    ck_assert_int_eq(t->capacity, 4);
+    id_table_cleanup(t);
+}
+END_TEST
+
+/* test inline struct values with integer keys */
+START_TEST(test_int_keys) {
+    struct id_table *t = id_table_init(2, 0.75);
+    ck_assert_ptr_nonnull(t);
+
+    for (unsigned long i = 0; i < 1000; i++) {
+        struct point p = { (int)i, (int)i * 2 };
+        ck_assert_int_eq(id_table_insert(t, i, p), 0);
+    }
+    ck_assert_int_eq(id_table_count(t), 1000);
+    ck_assert(id_table_load_factor(t) <= 0.75);
+
+    for (unsigned long i = 0; i < 1000; i++) {
+        struct point *p = id_table_lookup(t, i);
+        ck_assert_ptr_nonnull(p);
+        ck_assert_int_eq(p->x, (int)i);
+        ck_assert_int_eq(p->y, (int)i * 2);
+    }
+    ck_assert_ptr_null(id_table_lookup(t, 1000));
+
+    id_table_cleanup(t);
+}
+END_TEST
+
+/* test that string keys are copied and upsert finds existing keys */
+START_TEST(test_str_upsert) {
+    struct str_table *t = str_table_init(2, 1.0);
+    ck_assert_ptr_nonnull(t);
+
+    char *a = malloc(sizeof(char) * 4);
+    memcpy(a, "abc", sizeof(char) * 4);
+
+    int inserted = 0;
+    int *count = str_table_upsert(t, a, &inserted);
+    ck_assert_ptr_nonnull(count);
+    ck_assert_int_eq(inserted, 1);
+    ck_assert_int_eq(*count, 0);
+    (*count)++;
+
+    memcpy(a, "xyz", sizeof(char) * 4);
+    ck_assert_ptr_null(str_table_lookup(t, a));
+
+    count = str_table_upsert(t, "abc", &inserted);
+    ck_assert_ptr_nonnull(count);
+    ck_assert_int_eq(inserted, 0);
+    ck_assert_int_eq(*count, 1);
+
+    str_table_cleanup(t);
+    free(a);
+}
+END_TEST
+
+/* test delete */
+START_TEST(test_delete) {
+    struct str_table *t = str_table_init(1, 1.0);
+    ck_assert_ptr_nonnull(t);
+
+    ck_assert_int_eq(str_table_insert(t, "abc", 3), 0);
+    ck_assert_int_eq(str_table_insert(t, "ade", 5), 0);
+    ck_assert_int_eq(str_table_insert(t, "afg", 7), 0);
+
+    ck_assert_int_eq(str_table_delete(t, "ade"), 0);
+    ck_assert_int_eq(str_table_delete(t, "ade"), 1);
+    ck_assert_ptr_null(str_table_lookup(t, "ade"));
+    ck_assert_int_eq(*str_table_lookup(t, "abc"), 3);
+    ck_assert_int_eq(*str_table_lookup(t, "afg"), 7);
+    ck_assert_int_eq(str_table_count(t), 2);
+
+    str_table_cleanup(t);
+}
+END_TEST
+
+/* Adds the value of every visited key to the sum 'ctx'. */
+static int sum_visit(void *ctx, char *key, int *value) {
+    (void)key;
+    *(int *)ctx += *value;
+    return 0;
+}
+
+/* Stops the iteration at the first visited key. */
+static int stop_visit(void *ctx, char *key, int *value) {
+    (void)key;
+    (void)value;
+    (*(int *)ctx)++;
+    return 1;
+}
+
+/* test iterate */
+START_TEST(test_iterate) {
+    struct str_table *t = str_table_init(2, 1.0);
+    ck_assert_ptr_nonnull(t);
+
+    ck_assert_int_eq(str_table_insert(t, "abc", 3), 0);
+    ck_assert_int_eq(str_table_insert(t, "ade", 5), 0);
+    ck_assert_int_eq(str_table_insert(t, "afg", 7), 0);
+
+    int sum = 0;
+    ck_assert_int_eq(str_table_iterate(t, sum_visit, &sum), 0);
+    ck_assert_int_eq(sum, 15);
+
+    int visited = 0;
+    ck_assert_int_eq(str_table_iterate(t, stop_visit, &visited), 1);
+    ck_assert_int_eq(visited, 1);
+
+    str_table_cleanup(t);
+}
+END_TEST
+
+Suite *hash_table_generic_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Generic Hash Table");
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    /* Regular tests. */
+    tcase_add_test(tc_core, test_init);
+    tcase_add_test(tc_core, test_int_keys);
+    tcase_add_test(tc_core, test_str_upsert);
+    tcase_add_test(tc_core, test_delete);
+    tcase_add_test(tc_core, test_iterate);
+
+    suite_add_tcase(s, tc_core);
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = hash_table_generic_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -14,6 +14,21 @@
 #define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
 #endif
 
+/* Adds the number of values of 'value' to the total in 'ctx'. */
+static int sum_visit(void *ctx, const char *key, struct array *value) {
+    (void)key;
+    *(unsigned long *)ctx += array_size(value);
+    return 0;
+}
+
+/* Counts the visited keys in 'ctx' and stops after the first one. */
+static int stop_visit(void *ctx, const char *key, struct array *value) {
+    (void)key;
+    (void)value;
+    (*(int *)ctx)++;
+    return 1;
+}
+
 /* Tests */
 
 /* test init/cleanup */
@@ -110,6 +125,32 @@ START_TEST(test_add_chaining) {
 }
 END_TEST
 
+/* test that iterating visits every value once and can stop early */
+START_TEST(test_iterate) {
+    struct table *t;
+    t = table_init(2, 0.6, hash_too_simple);
+    ck_assert_ptr_nonnull(t);
+
+    unsigned long total = 0;
+    ck_assert_int_eq(table_iterate(t, sum_visit, &total), 0);
+    ck_assert_int_eq(total, 0);
+
+    ck_assert_int_eq(table_insert(t, "abc", 1), 0);
+    ck_assert_int_eq(table_insert(t, "abc", 2), 0);
+    ck_assert_int_eq(table_insert(t, "cba", 3), 0);
+    ck_assert_int_eq(table_insert(t, "xyz", 4), 0);
+    ck_assert_int_eq(table_iterate(t, sum_visit, &total), 0);
+    ck_assert_int_eq(total, 4);
+
+    int visited = 0;
+    ck_assert_int_eq(table_iterate(t, stop_visit, &visited), 1);
+    ck_assert_int_eq(visited, 1);
+    ck_assert_int_eq(table_iterate(NULL, sum_visit, &total), -1);
+
+    table_cleanup(t);
+}
+END_TEST
+
 Suite *hash_table_suite(void) {
     Suite *s;
     TCase *tc_core;
@@ -123,6 +164,7 @@ Suite *hash_table_suite(void) {
     tcase_add_test(tc_core, test_add_basic);
     tcase_add_test(tc_core, test_lookup_equals);
     tcase_add_test(tc_core, test_add_chaining);
+    tcase_add_test(tc_core, test_iterate);
 
     suite_add_tcase(s, tc_core);
     return s;
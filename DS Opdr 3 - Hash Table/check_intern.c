@@ -0,0 +1,120 @@
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+
+// For older versions of the check library
+#ifndef ck_assert_ptr_nonnull
+#define ck_assert_ptr_nonnull(X) _ck_assert_ptr(X, !=, NULL)
+#endif
+#ifndef ck_assert_ptr_null
+#define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
+#endif
+
+/* Tests */
+
+/* test init/cleanup */
+START_TEST(test_init) {
+    struct intern_pool *p = intern_init(2);
+    ck_assert_ptr_nonnull(p);
+    ck_assert_int_eq(intern_count(p), 0);
+    intern_cleanup(p);
+}
+END_TEST
+
+/* test that equal strings get the same id and a stable string */
+START_TEST(test_dedup) {
+    struct intern_pool *p = intern_init(2);
+    ck_assert_ptr_nonnull(p);
+
+    char *a = malloc(sizeof(char) * 4);
+    memcpy(a, "abc", sizeof(char) * 4);
+
+    unsigned long id_a = intern(p, a);
+    unsigned long id_b = intern(p, "def");
+    ck_assert_int_eq(id_a, 0);
+    ck_assert_int_eq(id_b, 1);
+    ck_assert_int_eq(intern(p, "abc"), id_a);
+    ck_assert_int_eq(intern_count(p), 2);
+
+    const char *str_a = intern_str(p, id_a);
+    ck_assert_ptr_ne(str_a, a);
+    ck_assert_int_eq(strcmp(str_a, "abc"), 0);
+
+    memcpy(a, "xyz", sizeof(char) * 4);
+    ck_assert_int_eq(strcmp(intern_str(p, id_a), "abc"), 0);
+
+    free(a);
+    intern_cleanup(p);
+}
+END_TEST
+
+/* test find without inserting */
+START_TEST(test_find) {
+    struct intern_pool *p = intern_init(1);
+    ck_assert_ptr_nonnull(p);
+
+    ck_assert(intern_find(p, "abc") == INTERN_NONE);
+    unsigned long id = intern(p, "abc");
+    ck_assert_int_eq(intern_find(p, "abc"), id);
+    ck_assert(intern_find(p, "abd") == INTERN_NONE);
+    ck_assert_ptr_null(intern_str(p, id + 1));
+    ck_assert_int_eq(intern_count(p), 1);
+
+    intern_cleanup(p);
+}
+END_TEST
+
+/* test that strings stay valid while the pool grows */
+START_TEST(test_stable_pointers) {
+    struct intern_pool *p = intern_init(1);
+    ck_assert_ptr_nonnull(p);
+
+    char word[16];
+    const char *first = intern_str(p, intern(p, "first"));
+    for (int i = 0; i < 20000; i++) {
+        snprintf(word, sizeof(word), "w%d", i);
+        ck_assert_int_eq(intern(p, word), i + 1);
+    }
+
+    ck_assert_ptr_eq(intern_str(p, intern(p, "first")), first);
+    ck_assert_int_eq(strcmp(intern_str(p, 12346), "w12345"), 0);
+    ck_assert_int_eq(intern_count(p), 20001);
+
+    intern_cleanup(p);
+}
+END_TEST
+
+Suite *intern_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Interning");
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    /* Regular tests. */
+    tcase_add_test(tc_core, test_init);
+    tcase_add_test(tc_core, test_dedup);
+    tcase_add_test(tc_core, test_find);
+    tcase_add_test(tc_core, test_stable_pointers);
+
+    suite_add_tcase(s, tc_core);
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = intern_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
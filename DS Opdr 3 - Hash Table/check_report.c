@@ -0,0 +1,155 @@
+#include <check.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "report.h"
+
+// For older versions of the check library
+#ifndef ck_assert_ptr_nonnull
+#define ck_assert_ptr_nonnull(X) _ck_assert_ptr(X, !=, NULL)
+#endif
+#ifndef ck_assert_ptr_null
+#define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
+#endif
+
+/* Adds 'count' occurences of 'word' to 'index'. */
+static void add_word(struct interned_index *index, const char *word,
+                     int count) {
+    char buf[16];
+    for (int i = 0; i < count; i++) {
+        strcpy(buf, word);
+        ck_assert_int_eq(interned_index_add(index, buf, i + 1), 0);
+    }
+}
+
+/* Tests */
+
+/* test that the top-K words come out ordered by count, then by word */
+START_TEST(test_top_k) {
+    struct intern_pool *pool = intern_init(4);
+    ck_assert_ptr_nonnull(pool);
+    struct interned_index *index = interned_index_init(pool, 4);
+    ck_assert_ptr_nonnull(index);
+
+    add_word(index, "one", 1);
+    add_word(index, "five", 5);
+    add_word(index, "three", 3);
+    add_word(index, "four", 4);
+    add_word(index, "tres", 3);
+    add_word(index, "two", 2);
+
+    struct word_count res[6];
+    ck_assert_int_eq(top_k_words(index, res, 4), 4);
+    ck_assert_str_eq(res[0].word, "five");
+    ck_assert_int_eq(res[0].count, 5);
+    ck_assert_str_eq(res[1].word, "four");
+    ck_assert_str_eq(res[2].word, "three");
+    ck_assert_str_eq(res[3].word, "tres");
+    ck_assert_int_eq(res[3].count, 3);
+
+    ck_assert_int_eq(top_k_words(index, res, 6), 6);
+    ck_assert_str_eq(res[5].word, "one");
+
+    interned_index_cleanup(index);
+    intern_cleanup(pool);
+}
+END_TEST
+
+/* test a k larger than the vocabulary */
+START_TEST(test_top_k_small) {
+    struct intern_pool *pool = intern_init(4);
+    ck_assert_ptr_nonnull(pool);
+    struct interned_index *index = interned_index_init(pool, 4);
+    ck_assert_ptr_nonnull(index);
+
+    struct word_count res[8];
+    ck_assert_int_eq(top_k_words(index, res, 8), 0);
+
+    add_word(index, "two", 2);
+    add_word(index, "one", 1);
+    ck_assert_int_eq(top_k_words(index, res, 8), 2);
+    ck_assert_str_eq(res[0].word, "two");
+    ck_assert_str_eq(res[1].word, "one");
+
+    interned_index_cleanup(index);
+    intern_cleanup(pool);
+}
+END_TEST
+
+/* test that words interned in a shared pool only count once they are added */
+START_TEST(test_shared_pool) {
+    struct intern_pool *pool = intern_init(4);
+    ck_assert_ptr_nonnull(pool);
+    struct interned_index *index = interned_index_init(pool, 1);
+    ck_assert_ptr_nonnull(index);
+
+    ck_assert(intern(pool, "query") != INTERN_NONE);
+    add_word(index, "word", 2);
+    ck_assert_int_eq(interned_index_count(index), 1);
+    ck_assert_ptr_null(interned_index_lookup(index, "query"));
+    ck_assert_ptr_null(interned_index_lookup(index, "missing"));
+    ck_assert_int_eq(array_size(interned_index_lookup(index, "word")), 2);
+
+    struct word_count res[2];
+    ck_assert_int_eq(top_k_words(index, res, 2), 1);
+    ck_assert_str_eq(res[0].word, "word");
+
+    add_word(index, "query", 1);
+    ck_assert_int_eq(interned_index_count(index), 2);
+    ck_assert_int_eq(array_get(interned_index_lookup(index, "query"), 0), 1);
+
+    interned_index_cleanup(index);
+    intern_cleanup(pool);
+}
+END_TEST
+
+/* test that the report of a k far beyond the vocabulary prints every word */
+START_TEST(test_report_large_k) {
+    struct intern_pool *pool = intern_init(4);
+    ck_assert_ptr_nonnull(pool);
+    struct interned_index *index = interned_index_init(pool, 4);
+    ck_assert_ptr_nonnull(index);
+
+    add_word(index, "two", 2);
+    add_word(index, "one", 1);
+    ck_assert_int_eq(print_frequency_report(index, ULONG_MAX), 0);
+    ck_assert_int_eq(print_frequency_report(index, 1UL << 60), 0);
+
+    interned_index_cleanup(index);
+    intern_cleanup(pool);
+}
+END_TEST
+
+Suite *report_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Report");
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    /* Regular tests. */
+    tcase_add_test(tc_core, test_top_k);
+    tcase_add_test(tc_core, test_top_k_small);
+    tcase_add_test(tc_core, test_shared_pool);
+    tcase_add_test(tc_core, test_report_large_k);
+
+    suite_add_tcase(s, tc_core);
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = report_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "word_index.h"
+
+// For older versions of the check library
+#ifndef ck_assert_ptr_nonnull
+#define ck_assert_ptr_nonnull(X) _ck_assert_ptr(X, !=, NULL)
+#endif
+#ifndef ck_assert_ptr_null
+#define ck_assert_ptr_null(X) _ck_assert_ptr(X, ==, NULL)
+#endif
+
+#define STREAM_FILE "check_word_stream.tmp"
+
+/* Writes 'text' to the test file, truncating it first if 'mode' is "w". */
+static void write_file(const char *mode, const char *text) {
+    FILE *fp = fopen(STREAM_FILE, mode);
+    ck_assert_ptr_nonnull(fp);
+    fputs(text, fp);
+    fclose(fp);
+}
+
+/* Tests */
+
+/* test that only appended lines are indexed, with continued line numbers */
+START_TEST(test_append) {
+    write_file("w", "one two\nthree\n");
+
+    struct word_table *t = word_table_init(8, 1.0);
+    ck_assert_ptr_nonnull(t);
+    struct word_stream *s = word_stream_init(STREAM_FILE);
+    ck_assert_ptr_nonnull(s);
+
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 2);
+    ck_assert_int_eq(word_stream_offset(s), 14);
+    ck_assert_int_eq(word_stream_line(s), 2);
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 0);
+
+    write_file("a", "Two four\n");
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 1);
+    ck_assert_int_eq(word_stream_line(s), 3);
+
+    struct array **lines = word_table_lookup(t, "two");
+    ck_assert_ptr_nonnull(lines);
+    ck_assert_int_eq(array_size(*lines), 2);
+    ck_assert_int_eq(array_get(*lines, 0), 1);
+    ck_assert_int_eq(array_get(*lines, 1), 3);
+    ck_assert_int_eq(array_get(*word_table_lookup(t, "four"), 0), 3);
+
+    word_stream_cleanup(s);
+    word_table_cleanup(t);
+    remove(STREAM_FILE);
+}
+END_TEST
+
+/* test that an unfinished last line waits for its newline */
+START_TEST(test_partial_line) {
+    write_file("w", "one\ntw");
+
+    struct word_table *t = word_table_init(8, 1.0);
+    ck_assert_ptr_nonnull(t);
+    struct word_stream *s = word_stream_init(STREAM_FILE);
+    ck_assert_ptr_nonnull(s);
+
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 1);
+    ck_assert_ptr_null(word_table_lookup(t, "tw"));
+
+    write_file("a", "o\n");
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 1);
+    ck_assert_int_eq(array_get(*word_table_lookup(t, "two"), 0), 2);
+    ck_assert_ptr_null(word_table_lookup(t, "tw"));
+
+    word_stream_cleanup(s);
+    word_table_cleanup(t);
+    remove(STREAM_FILE);
+}
+END_TEST
+
+/* test that a line starting with a NUL byte is still counted */
+START_TEST(test_nul_line) {
+    FILE *fp = fopen(STREAM_FILE, "w");
+    ck_assert_ptr_nonnull(fp);
+    fwrite("\0one\ntwo\n\0", 1, 10, fp);
+    fclose(fp);
+
+    struct word_table *t = word_table_init(8, 1.0);
+    ck_assert_ptr_nonnull(t);
+    struct word_stream *s = word_stream_init(STREAM_FILE);
+    ck_assert_ptr_nonnull(s);
+
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 2);
+    ck_assert_int_eq(word_stream_offset(s), 9);
+    ck_assert_ptr_null(word_table_lookup(t, "one"));
+    ck_assert_int_eq(array_get(*word_table_lookup(t, "two"), 0), 2);
+
+    word_stream_cleanup(s);
+    word_table_cleanup(t);
+    remove(STREAM_FILE);
+}
+END_TEST
+
+/* test that a truncated file is reported */
+START_TEST(test_truncated) {
+    write_file("w", "one two\nthree\n");
+
+    struct word_table *t = word_table_init(8, 1.0);
+    ck_assert_ptr_nonnull(t);
+    struct word_stream *s = word_stream_init(STREAM_FILE);
+    ck_assert_ptr_nonnull(s);
+
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), 2);
+    write_file("w", "one\n");
+    ck_assert_int_eq(word_stream_update(s, word_table_add, t), -1);
+
+    word_stream_cleanup(s);
+    word_table_cleanup(t);
+    remove(STREAM_FILE);
+}
+END_TEST
+
+Suite *word_stream_suite(void) {
+    Suite *s;
+    TCase *tc_core;
+
+    s = suite_create("Word Stream");
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    /* Regular tests. */
+    tcase_add_test(tc_core, test_append);
+    tcase_add_test(tc_core, test_partial_line);
+    tcase_add_test(tc_core, test_truncated);
+    tcase_add_test(tc_core, test_nul_line);
+
+    suite_add_tcase(s, tc_core);
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = word_stream_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -5,7 +5,7 @@ Ssid:15225054
 This program initializes and configures a resizing hash table,
 that uses a linked list implemetation and its functions, which
 include a cleanup, bucket resize, insert, lookup,load factor,
-delete, cleanup function.*/
+delete, iterate, cleanup function.*/
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -212,6 +212,24 @@ int table_delete(struct table *t, const char *key) {
     return 1;
 }
 
+int table_iterate(const struct table *t,
+                  int (*visit)(void *ctx, const char *key, struct array *value),
+                  void *ctx) {
+    if (t == NULL || visit == NULL) {
+        return -1;
+    }
+
+    for (unsigned long int i = 0; i < t->capacity; i++) {
+        for (struct node *n = t->array[i]; n != NULL; n = n->next) {
+            if (visit(ctx, n->key, n->value) != 0) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
 void table_cleanup(struct table *t) {
     if (t == NULL) {
         return;
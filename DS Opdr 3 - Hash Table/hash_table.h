@@ -39,5 +39,14 @@ double table_load_factor(const struct table *t);
  * Returns -1 if an error occured. */
 int table_delete(struct table *t, const char *key);
 
+/* Calls 'visit' with 'ctx' for every key and its array of values in the
+ * hash table, in no particular order. Stops as soon as 'visit' returns
+ * non-zero. The table must not be changed while iterating.
+ * Returns 0 if every key was visited, 1 if 'visit' stopped the iteration
+ * and -1 if an error occured. */
+int table_iterate(const struct table *t,
+                  int (*visit)(void *ctx, const char *key, struct array *value),
+                  void *ctx);
+
 /* Clean up the hash table data structure. */
 void table_cleanup(struct table *t);
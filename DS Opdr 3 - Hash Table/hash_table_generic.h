@@ -0,0 +1,310 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+Generic hash table "template". HASH_TABLE_DEFINE stamps out a chaining hash
+table that is specialized for one key type and one value type. The hash,
+equality, copy and free operations are passed as function (or function-like
+macro) names, so they are fixed at compile time and can be inlined by the
+compiler. Keys and values are stored directly inside the nodes.*/
+
+#ifndef _HASH_TABLE_GENERIC_H_
+#define _HASH_TABLE_GENERIC_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Copy hook for plain value keys (integers, handles, pointers that are not
+ * owned by the table). Always succeeds. */
+#define HT_COPY_PLAIN(dst, src) (*(dst) = (src), 0)
+
+/* Free hook for keys and values that do not own any memory. */
+#define HT_FREE_NONE(x) ((void)(x))
+
+/* djb2 string hash, identical to hash_djb2() but visible to the compiler. */
+static inline unsigned long ht_str_hash(const char *str) {
+    unsigned long hash = 5381;
+    unsigned long c;
+
+    while ((c = (unsigned char)*str++)) {
+        hash = ((hash << 5) + hash) + c;
+    }
+    return hash;
+}
+
+static inline int ht_str_eq(const char *a, const char *b) {
+    return strcmp(a, b) == 0;
+}
+
+/* Copies string 'src' into a new heap string stored at 'dst'.
+ * Returns 0 if successful and 1 otherwise. */
+static inline int ht_str_copy(char **dst, const char *src) {
+    size_t len = strlen(src) + 1;
+
+    *dst = malloc(len);
+    if (*dst == NULL) {
+        return 1;
+    }
+    memcpy(*dst, src, len);
+    return 0;
+}
+
+static inline void ht_str_free(char *str) {
+    free(str);
+}
+
+/* Integer hash (finalizer of MurmurHash3), spreads consecutive ids over
+ * all bits so they can be masked into a power of two sized bucket array. */
+static inline unsigned long ht_ulong_hash(unsigned long x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdUL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53UL;
+    x ^= x >> 33;
+    return x;
+}
+
+static inline int ht_ulong_eq(unsigned long a, unsigned long b) {
+    return a == b;
+}
+
+/* Defines 'struct name' and the following functions:
+ *
+ * struct name *name_init(unsigned long capacity, double max_load_factor)
+ *     Returns a new table or NULL on failure. The capacity is rounded up to a
+ *     power of two.
+ * value_type *name_lookup(const struct name *t, key_type key)
+ *     Returns a pointer to the stored value or NULL if the key is absent.
+ * value_type *name_upsert(struct name *t, key_type key, int *inserted)
+ *     Returns a pointer to the value for 'key', adding the key (copied with
+ *     key_copy_fn) with a zeroed value if it was not present yet. '*inserted'
+ *     is set to 1 in that case and to 0 otherwise. Returns NULL on failure.
+ * int name_insert(struct name *t, key_type key, value_type value)
+ *     Stores 'value' for 'key', freeing any previous value.
+ *     Returns 0 if successful and 1 otherwise.
+ * int name_delete(struct name *t, key_type key)
+ *     Returns 0 if the key was removed, 1 if it was not present and -1 if an
+ *     error occured.
+ * double name_load_factor(const struct name *t)
+ * unsigned long name_count(const struct name *t)
+ * int name_iterate(const struct name *t,
+ *                  int (*visit)(void *ctx, key_type key, value_type *value),
+ *                  void *ctx)
+ *     Calls 'visit' for every key and value until it returns non-zero.
+ *     Returns 0 if every key was visited, 1 if 'visit' stopped early and -1
+ *     if an error occured. The table must not be changed while iterating.
+ * void name_cleanup(struct name *t)
+ *
+ * hash_fn(key) returns an unsigned long, eq_fn(a, b) returns non-zero for
+ * equal keys, key_copy_fn(&dst, key) returns 0 on success and
+ * key_free_fn(key) / value_free_fn(value) release a stored key or value. */
+#define HASH_TABLE_DEFINE(name, key_type, value_type, hash_fn, eq_fn,         \
+                          key_copy_fn, key_free_fn, value_free_fn)             \
+                                                                               \
+struct name##_node {                                                           \
+    key_type key;                                                              \
+    value_type value;                                                          \
+    unsigned long hash;                                                        \
+    struct name##_node *next;                                                  \
+};                                                                             \
+                                                                               \
+struct name {                                                                  \
+    struct name##_node **array;                                                \
+    double max_load_factor;                                                    \
+    unsigned long capacity;                                                    \
+    unsigned long load;                                                        \
+};                                                                             \
+                                                                               \
+static inline struct name *name##_init(unsigned long capacity,                \
+                                       double max_load_factor) {              \
+    unsigned long rounded = 1;                                                 \
+    while (rounded < capacity) {                                               \
+        rounded <<= 1;                                                         \
+    }                                                                          \
+                                                                               \
+    struct name *t = malloc(sizeof(struct name));                              \
+    if (t == NULL) {                                                           \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    t->array = calloc(rounded, sizeof(struct name##_node *));                  \
+    if (t->array == NULL) {                                                    \
+        free(t);                                                               \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    t->capacity = rounded;                                                     \
+    t->max_load_factor = max_load_factor;                                      \
+    t->load = 0;                                                               \
+    return t;                                                                  \
+}                                                                              \
+                                                                               \
+/* Doubles the bucket array, reusing the cached hash of every node. */        \
+static inline int name##_resize(struct name *t) {                             \
+    unsigned long new_capacity = t->capacity * 2;                              \
+    struct name##_node **re_array =                                            \
+        calloc(new_capacity, sizeof(struct name##_node *));                    \
+    if (re_array == NULL) {                                                    \
+        return 1;                                                              \
+    }                                                                          \
+                                                                               \
+    for (unsigned long i = 0; i < t->capacity; i++) {                          \
+        struct name##_node *to_move = t->array[i];                             \
+        while (to_move != NULL) {                                              \
+            struct name##_node *next = to_move->next;                          \
+            unsigned long index = to_move->hash & (new_capacity - 1);          \
+            to_move->next = re_array[index];                                   \
+            re_array[index] = to_move;                                         \
+            to_move = next;                                                    \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    free(t->array);                                                            \
+    t->array = re_array;                                                       \
+    t->capacity = new_capacity;                                                \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline struct name##_node *name##_find(const struct name *t,           \
+                                              key_type key,                    \
+                                              unsigned long hash) {            \
+    struct name##_node *node = t->array[hash & (t->capacity - 1)];             \
+    while (node != NULL) {                                                     \
+        if (node->hash == hash && eq_fn(node->key, key)) {                     \
+            return node;                                                       \
+        }                                                                      \
+        node = node->next;                                                     \
+    }                                                                          \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+static inline value_type *name##_lookup(const struct name *t, key_type key) { \
+    if (t == NULL) {                                                           \
+        return NULL;                                                           \
+    }                                                                          \
+    struct name##_node *node = name##_find(t, key, hash_fn(key));              \
+    return node == NULL ? NULL : &node->value;                                 \
+}                                                                              \
+                                                                               \
+static inline value_type *name##_upsert(struct name *t, key_type key,         \
+                                        int *inserted) {                       \
+    if (t == NULL || inserted == NULL) {                                       \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    unsigned long hash = hash_fn(key);                                         \
+    struct name##_node *node = name##_find(t, key, hash);                      \
+    if (node != NULL) {                                                        \
+        *inserted = 0;                                                         \
+        return &node->value;                                                   \
+    }                                                                          \
+                                                                               \
+    if ((double)(t->load + 1) > t->max_load_factor * (double)t->capacity) {    \
+        if (name##_resize(t) != 0) {                                           \
+            return NULL;                                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    node = calloc(1, sizeof(struct name##_node));                              \
+    if (node == NULL) {                                                        \
+        return NULL;                                                           \
+    }                                                                          \
+    if (key_copy_fn(&node->key, key) != 0) {                                   \
+        free(node);                                                            \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    unsigned long index = hash & (t->capacity - 1);                            \
+    node->hash = hash;                                                         \
+    node->next = t->array[index];                                              \
+    t->array[index] = node;                                                    \
+    t->load++;                                                                 \
+                                                                               \
+    *inserted = 1;                                                             \
+    return &node->value;                                                       \
+}                                                                              \
+                                                                               \
+static inline int name##_insert(struct name *t, key_type key,                 \
+                                value_type value) {                            \
+    int inserted = 0;                                                          \
+    value_type *slot = name##_upsert(t, key, &inserted);                       \
+    if (slot == NULL) {                                                        \
+        return 1;                                                              \
+    }                                                                          \
+    if (!inserted) {                                                           \
+        value_free_fn(*slot);                                                  \
+    }                                                                          \
+    *slot = value;                                                             \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int name##_delete(struct name *t, key_type key) {               \
+    if (t == NULL) {                                                           \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    unsigned long hash = hash_fn(key);                                         \
+    struct name##_node **link = &t->array[hash & (t->capacity - 1)];           \
+    while (*link != NULL) {                                                    \
+        struct name##_node *current = *link;                                   \
+        if (current->hash == hash && eq_fn(current->key, key)) {               \
+            *link = current->next;                                             \
+            key_free_fn(current->key);                                         \
+            value_free_fn(current->value);                                     \
+            free(current);                                                     \
+            t->load--;                                                         \
+            return 0;                                                          \
+        }                                                                      \
+        link = &current->next;                                                 \
+    }                                                                          \
+    return 1;                                                                  \
+}                                                                              \
+                                                                               \
+static inline double name##_load_factor(const struct name *t) {               \
+    if (t == NULL || t->capacity == 0) {                                       \
+        return -1.0;                                                           \
+    }                                                                          \
+    return (double)t->load / (double)t->capacity;                              \
+}                                                                              \
+                                                                               \
+static inline unsigned long name##_count(const struct name *t) {              \
+    return t == NULL ? 0 : t->load;                                            \
+}                                                                              \
+                                                                               \
+static inline int name##_iterate(const struct name *t,                        \
+                                 int (*visit)(void *ctx, key_type key,        \
+                                              value_type *value),             \
+                                 void *ctx) {                                 \
+    if (t == NULL || visit == NULL) {                                          \
+        return -1;                                                             \
+    }                                                                          \
+    for (unsigned long i = 0; i < t->capacity; i++) {                          \
+        struct name##_node *node = t->array[i];                                \
+        for (; node != NULL; node = node->next) {                              \
+            if (visit(ctx, node->key, &node->value) != 0) {                    \
+                return 1;                                                      \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void name##_cleanup(struct name *t) {                           \
+    if (t == NULL) {                                                           \
+        return;                                                                \
+    }                                                                          \
+    for (unsigned long i = 0; i < t->capacity; i++) {                          \
+        struct name##_node *to_free = t->array[i];                             \
+        while (to_free != NULL) {                                              \
+            struct name##_node *next = to_free->next;                          \
+            key_free_fn(to_free->key);                                         \
+            value_free_fn(to_free->value);                                     \
+            free(to_free);                                                     \
+            to_free = next;                                                    \
+        }                                                                      \
+    }                                                                          \
+    free(t->array);                                                            \
+    free(t);                                                                   \
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+This program implements a string interning pool. The strings are copied
+into large chunks that never move, so every interned string has a stable
+address, and a generic hash table maps the strings to their ids.*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_table_generic.h"
+#include "intern.h"
+
+#define INTERN_CHUNK_SIZE 65536
+#define INTERN_MAX_LOAD 1.0
+
+HASH_TABLE_DEFINE(intern_map, const char *, unsigned long, ht_str_hash,
+                  ht_str_eq, HT_COPY_PLAIN, HT_FREE_NONE, HT_FREE_NONE)
+
+struct intern_chunk {
+    struct intern_chunk *next;
+    size_t used;
+    size_t size;
+    char data[];
+};
+
+struct intern_pool {
+    struct intern_map *map;
+    const char **strings;
+    unsigned long count;
+    unsigned long capacity;
+    struct intern_chunk *chunks;
+};
+
+struct intern_pool *intern_init(unsigned long capacity) {
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    struct intern_pool *p = malloc(sizeof(struct intern_pool));
+    if (p == NULL) {
+        return NULL;
+    }
+
+    p->strings = malloc(capacity * sizeof(const char *));
+    if (p->strings == NULL) {
+        free(p);
+        return NULL;
+    }
+
+    p->map = intern_map_init(capacity, INTERN_MAX_LOAD);
+    if (p->map == NULL) {
+        free(p->strings);
+        free(p);
+        return NULL;
+    }
+
+    p->count = 0;
+    p->capacity = capacity;
+    p->chunks = NULL;
+    return p;
+}
+
+/*Function that reserves room for 'len' bytes in the newest chunk of the
+pool, starting a new chunk if it does not fit.
+
+Input: struct intern_pool *p, the pool. size_t len, the number of bytes.
+
+Output: returns a pointer to the reserved bytes or NULL on failure.*/
+static char *chunk_alloc(struct intern_pool *p, size_t len) {
+    struct intern_chunk *chunk = p->chunks;
+
+    if (chunk == NULL || chunk->size - chunk->used < len) {
+        size_t size = len > INTERN_CHUNK_SIZE ? len : INTERN_CHUNK_SIZE;
+        chunk = malloc(sizeof(struct intern_chunk) + size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->used = 0;
+        chunk->size = size;
+        chunk->next = p->chunks;
+        p->chunks = chunk;
+    }
+
+    char *res = chunk->data + chunk->used;
+    chunk->used += len;
+    return res;
+}
+
+unsigned long intern(struct intern_pool *p, const char *str) {
+    if (p == NULL || str == NULL) {
+        return INTERN_NONE;
+    }
+
+    if (p->count == p->capacity) {
+        const char **tmp = realloc(p->strings,
+                                   p->capacity * 2 * sizeof(const char *));
+        if (tmp == NULL) {
+            return INTERN_NONE;
+        }
+        p->strings = tmp;
+        p->capacity *= 2;
+    }
+
+    /* Copy the string up front so a single hash table operation suffices,
+     * the copy is handed back to the chunk if the string already exists. */
+    size_t len = strlen(str) + 1;
+    char *copy = chunk_alloc(p, len);
+    if (copy == NULL) {
+        return INTERN_NONE;
+    }
+    memcpy(copy, str, len);
+
+    int inserted = 0;
+    unsigned long *id = intern_map_upsert(p->map, copy, &inserted);
+    if (id == NULL || !inserted) {
+        p->chunks->used -= len;
+        return id == NULL ? INTERN_NONE : *id;
+    }
+
+    *id = p->count;
+    p->strings[p->count] = copy;
+    return p->count++;
+}
+
+unsigned long intern_find(const struct intern_pool *p, const char *str) {
+    if (p == NULL || str == NULL) {
+        return INTERN_NONE;
+    }
+
+    unsigned long *id = intern_map_lookup(p->map, str);
+    return id == NULL ? INTERN_NONE : *id;
+}
+
+const char *intern_str(const struct intern_pool *p, unsigned long id) {
+    if (p == NULL || id >= p->count) {
+        return NULL;
+    }
+    return p->strings[id];
+}
+
+unsigned long intern_count(const struct intern_pool *p) {
+    return p == NULL ? 0 : p->count;
+}
+
+void intern_cleanup(struct intern_pool *p) {
+    if (p == NULL) {
+        return;
+    }
+
+    struct intern_chunk *chunk = p->chunks;
+    while (chunk != NULL) {
+        struct intern_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    intern_map_cleanup(p->map);
+    free(p->strings);
+    free(p);
+}
@@ -0,0 +1,40 @@
+/* String interning interface
+ * Stores every distinct string once and hands out a stable id for it, so
+ * strings can be kept and compared as integers. */
+
+#ifndef _INTERN_H_
+#define _INTERN_H_
+
+#include <limits.h>
+
+/* Returned instead of an id if a string is not interned or on failure. */
+#define INTERN_NONE ULONG_MAX
+
+/* Handle to the interning pool. */
+struct intern_pool;
+
+/* Initialise an interning pool with room for 'capacity' strings before
+ * resizing. Returns a pointer to the pool or NULL on failure. */
+struct intern_pool *intern_init(unsigned long capacity);
+
+/* Returns the id of 'str', copying 'str' into the pool if it was not
+ * interned before. Ids are handed out consecutively from 0, so equal ids
+ * mean equal strings. Returns INTERN_NONE on failure. */
+unsigned long intern(struct intern_pool *p, const char *str);
+
+/* Returns the id of 'str' without adding it to the pool.
+ * Returns INTERN_NONE if 'str' is not interned. */
+unsigned long intern_find(const struct intern_pool *p, const char *str);
+
+/* Returns the interned string with 'id'. The pointer stays valid until the
+ * pool is cleaned up, so interned strings can also be compared by pointer.
+ * Returns NULL if 'id' is not a valid id. */
+const char *intern_str(const struct intern_pool *p, unsigned long id);
+
+/* Returns the number of distinct strings in the pool. */
+unsigned long intern_count(const struct intern_pool *p);
+
+/* Clean up the pool and all interned strings. */
+void intern_cleanup(struct intern_pool *p);
+
+#endif
@@ -2,121 +2,57 @@
 Name: Boris Vukajlovic
 Ssid:15225054
 
-This program fills an hash table with data, which has been read
-from a file stream. It also includes numerous functions which
-manipulate and test this hash table, which include cleanup input
-string, calc_delim, creating a table from a file, using stdin
-to look up certain keys and their corresponding values and a
-performance benchmark.
+This program fills a word index with data, which has been read
+from a file stream, and uses stdin to look up certain keys and
+their corresponding values. The word index itself is built in
+word_index.c and the performance benchmark lives in bench.c.
 */
 
-#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 #include "array.h"
-#include "hash_func.h"
-#include "hash_table.h"
-
-#define LINE_LENGTH 256
+#include "bench.h"
+#include "intern.h"
+#include "report.h"
+#include "word_index.h"
 
 #define TABLE_START_SIZE 65536
-#define MAX_LOAD_FACTOR 1.0
-#define HASH_FUNCTION hash_djb2
-
-#define START_TESTS 2
-#define MAX_TESTS 2
-#define HASH_TESTS 3
-
-/* Replace every non-ascii char with a space and lowercase every char. */
-static void cleanup_string(char *line) {
-    for (char *c = line; *c != '\0'; c++) {
-        *c = (char) tolower(*c);
-        if (!isalpha(*c)) {
-            *c = ' ';
-        }
-    }
-}
-
-/* Return a pointer to a heap allocated string with all the characters we
- * use as word delimiters. Return NULL on failure. */
-static char *calc_delim(void) {
-    const size_t ascii_table_size = 128;
-    char *res = malloc(sizeof(char) * ascii_table_size);
-    if (!res) {
-        return NULL;
-    }
-
-    int res_index = 0;
-    for (unsigned char c = 1; c < ascii_table_size; c++) {
-        if (!isalpha(c)) {   /* if it's not an alpha it's a delimiter char. */
-            res[res_index++] = (char) c;
-        }
-    }
-    res[res_index] = '\0';
-    return res;
-}
-
-/* Creates a hash table with a word index for the specified file and
- * parameters. Return a pointer to hash table or NULL if an error occured.
- */
-static struct table *create_from_file(char *filename,
-                               unsigned long start_size,
-                               double max_load,
-                               unsigned long (*hash_func)(const unsigned char *)) {
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL) {
-        return NULL;
-    }
-
-    char *line = malloc(LINE_LENGTH * sizeof(char));
-    if (!line) {
-        fclose(fp);
-        return NULL;
-    }
-
-    struct table *hash_table = table_init(start_size, max_load, hash_func);
-
-    int line_number = 0;
-    char *delim = (char *)calc_delim();
-    while (fgets(line, LINE_LENGTH, fp)) {
-
-        cleanup_string(line);
-        char *word = strtok(line, delim);
-        line_number++;
-
-        while (word != NULL) {
-            table_insert(hash_table, word, line_number);
-            word = strtok(NULL, delim);
-        }
-    }
 
-    free(delim);
-    fclose(fp);
-    free(line);
-
-    return hash_table;
-}
-
-/* Reads words from stdin and prints line lookup results per word.
+/* Reads words from stdin and prints line lookup results per word. If
+ * 'stream' is not NULL the text appended to the indexed file is added to
+ * the index before every lookup.
  * Return 0 if succesful and 1 on failure. */
-static int stdin_lookup(struct table *hash_table) {
+static int stdin_lookup(struct interned_index *index,
+                        struct word_stream *stream) {
     char *line = malloc(LINE_LENGTH * sizeof(char));
     if (!line) {
         return 1;
     }
 
-    char *delim = (char *)calc_delim();
+    char *delim = calc_delim();
+    if (!delim) {
+        free(line);
+        return 1;
+    }
     while (fgets(line, LINE_LENGTH, stdin)) {
 
+        if (stream != NULL &&
+            word_stream_update(stream, interned_index_add, index) < 0) {
+            free(delim);
+            free(line);
+            return 1;
+        }
+
         cleanup_string(line);
         char *word = strtok(line, delim);
 
-            struct array *word_array = table_lookup(hash_table, word);
+            struct array *word_array = interned_index_lookup(index, word);
+            /* array_size() is undefined for words that are not indexed. */
+            unsigned long size = word_array ? array_size(word_array) : 0;
             printf("%s\n", word);
-            for (unsigned long int i = 0; i < array_size(word_array); i++) {
+            for (unsigned long int i = 0; i < size; i++) {
                 printf("* %d\n", array_get(word_array, i));
             }
             printf("\n");
@@ -127,55 +63,66 @@ static int stdin_lookup(struct table *hash_table) {
     return 0;
 }
 
-/* Tests hash fucntions against eachother and provides information about the
-fastest performing times, like the max load and the starting size.
-
-Input: char *filename, the filename that will be read.
-
-Side effect: prints the benchmark on the stdout stream.*/
-static void timed_construction(char *filename) {
-
-    unsigned long start_sizes[START_TESTS] = { 2, 65536 };
-    double max_loads[MAX_TESTS] = { 0.2, 1.0 };
-    unsigned long (*hash_funcs[HASH_TESTS])(const unsigned char *) = { hash_too_simple, hash_djb2, hash_k_and_r_v2 };
-
-    for (int i = 0; i < START_TESTS; i++) {
-        for (int j = 0; j < MAX_TESTS; j++) {
-            for (int k = 0; k < HASH_TESTS; k++) {
-                clock_t start = clock();
-                struct table *hash_table =
-                create_from_file(filename, start_sizes[i], max_loads[j], hash_funcs[k]);
-                clock_t end = clock();
-
-                printf("Start: %ld\tMax: %.1f\tHash: %d\t -> Time: %ld "
-                       "microsecs\n",
-                       start_sizes[i], max_loads[j], k, end - start);
-                table_cleanup(hash_table);
-            }
-        }
+/* Indexes 'filename' incrementally and answers lookups from stdin, adding
+ * the lines appended to the file in the meantime before every lookup.
+ * Return 0 if succesful and 1 on failure. */
+static int follow_lookup(char *filename) {
+    struct intern_pool *pool = intern_init(TABLE_START_SIZE);
+    struct word_stream *stream = word_stream_init(filename);
+    struct interned_index *index = interned_index_init(pool, TABLE_START_SIZE);
+
+    int ret = 1;
+    if (stream && index &&
+        word_stream_update(stream, interned_index_add, index) >= 0) {
+        ret = stdin_lookup(index, stream);
     }
+
+    interned_index_cleanup(index);
+    word_stream_cleanup(stream);
+    intern_cleanup(pool);
+    return ret;
 }
 
 int main(int argc, char *argv[]) {
     if (argc < 2) {
-        printf("usage: %s text_file [-t]\n", argv[0]);
+        printf("usage: %s text_file [-f | -k [k] | -t [runs [warmup]]]\n",
+               argv[0]);
         return EXIT_FAILURE;
     }
 
-    if (argc == 3 && !strcmp(argv[2], "-t")) {
-        timed_construction(argv[1]);
+    if (argc >= 3 && !strcmp(argv[2], "-t")) {
+        int runs = argc >= 4 ? atoi(argv[3]) : BENCH_RUNS;
+        int warmup = argc >= 5 ? atoi(argv[4]) : BENCH_WARMUP;
+        if (bench_run(argv[1], runs, warmup) != 0) {
+            printf("An error occured running the benchmark, exiting..\n");
+            return EXIT_FAILURE;
+        }
+    } else if (argc >= 3 && !strcmp(argv[2], "-f")) {
+        if (follow_lookup(argv[1]) != 0) {
+            printf("An error occured following the file, exiting..\n");
+            return EXIT_FAILURE;
+        }
     } else {
-        struct table *hash_table =
-        create_from_file(argv[1], TABLE_START_SIZE, MAX_LOAD_FACTOR, HASH_FUNCTION);
-        if (hash_table == NULL) {
+        struct intern_pool *pool = intern_init(TABLE_START_SIZE);
+        struct interned_index *index = create_interned_from_file(
+            argv[1], pool, TABLE_START_SIZE);
+        if (index == NULL) {
             printf("An error occured creating the hash table, exiting..\n");
+            intern_cleanup(pool);
             return EXIT_FAILURE;
         }
-        if (stdin_lookup(hash_table) != 0) {
-            table_cleanup(hash_table);
+        int ret;
+        if (argc >= 3 && !strcmp(argv[2], "-k")) {
+            long k = argc >= 4 ? atol(argv[3]) : REPORT_TOP_K;
+            ret = k < 0 ? 1 : print_frequency_report(index, (unsigned long)k);
+        } else {
+            ret = stdin_lookup(index, NULL);
+        }
+        interned_index_cleanup(index);
+        intern_cleanup(pool);
+        if (ret != 0) {
             return EXIT_FAILURE;
         }
-        table_cleanup(hash_table);
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,157 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+This program reports the most frequent words of a word index and a
+histogram of the word frequencies. The top-K words are selected with a
+bounded min-heap while iterating over the index once.*/
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "report.h"
+
+#define HISTOGRAM_BUCKETS (sizeof(unsigned long) * CHAR_BIT)
+
+struct top_k {
+    const struct intern_pool *pool;
+    struct word_count *heap;
+    unsigned long size;
+    unsigned long k;
+};
+
+/* Returns non-zero if 'a' ranks below 'b': a lower count, or an equal count
+ * and a word that comes later in the alphabet. */
+static int ranks_below(const struct word_count *a, const struct word_count *b) {
+    if (a->count != b->count) {
+        return a->count < b->count;
+    }
+    return strcmp(a->word, b->word) > 0;
+}
+
+static void swap_counts(struct word_count *a, struct word_count *b) {
+    struct word_count tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/* Restores the min-heap property downwards from 'i'. */
+static void sift_down(struct word_count *heap, unsigned long size,
+                      unsigned long i) {
+    while (2 * i + 1 < size) {
+        unsigned long child = 2 * i + 1;
+        if (child + 1 < size && ranks_below(&heap[child + 1], &heap[child])) {
+            child++;
+        }
+        if (!ranks_below(&heap[child], &heap[i])) {
+            return;
+        }
+        swap_counts(&heap[i], &heap[child]);
+        i = child;
+    }
+}
+
+/* Restores the min-heap property upwards from 'i'. */
+static void sift_up(struct word_count *heap, unsigned long i) {
+    while (i > 0 && ranks_below(&heap[i], &heap[(i - 1) / 2])) {
+        swap_counts(&heap[i], &heap[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+}
+
+/* Offers one word of the index to the top-K heap 'ctx'. */
+static int top_k_visit(void *ctx, unsigned long id, struct array *lines) {
+    struct top_k *top = ctx;
+    struct word_count wc = { intern_str(top->pool, id), array_size(lines) };
+
+    if (top->size < top->k) {
+        top->heap[top->size] = wc;
+        sift_up(top->heap, top->size++);
+    } else if (ranks_below(&top->heap[0], &wc)) {
+        top->heap[0] = wc;
+        sift_down(top->heap, top->size, 0);
+    }
+    return 0;
+}
+
+unsigned long top_k_words(const struct interned_index *index,
+                          struct word_count *res, unsigned long k) {
+    if (index == NULL || res == NULL || k == 0) {
+        return 0;
+    }
+
+    struct top_k top = { index->pool, res, 0, k };
+    interned_index_iterate(index, top_k_visit, &top);
+
+    /* Heap sort in place: repeatedly move the lowest ranked word to the
+     * back, which leaves the most frequent word in front. */
+    for (unsigned long end = top.size; end > 1; end--) {
+        swap_counts(&res[0], &res[end - 1]);
+        sift_down(res, end - 1, 0);
+    }
+    return top.size;
+}
+
+/* Counts one word of the index in the histogram 'ctx'. */
+static int histogram_visit(void *ctx, unsigned long id, struct array *lines) {
+    (void)id;
+    unsigned long *histogram = ctx;
+    unsigned long count = array_size(lines);
+
+    unsigned long bucket = 0;
+    while (count > 1) {
+        count >>= 1;
+        bucket++;
+    }
+    histogram[bucket]++;
+    return 0;
+}
+
+int print_frequency_report(const struct interned_index *index,
+                           unsigned long k) {
+    if (index == NULL) {
+        return 1;
+    }
+
+    /* There are never more than count words to report, so a huge 'k' does
+     * not need a huge buffer. */
+    unsigned long count = interned_index_count(index);
+    if (k > count) {
+        k = count;
+    }
+    if (k > SIZE_MAX / sizeof(struct word_count)) {
+        return 1;
+    }
+
+    struct word_count *top = malloc((k ? k : 1) * sizeof(struct word_count));
+    if (top == NULL) {
+        return 1;
+    }
+
+    unsigned long n = top_k_words(index, top, k);
+    printf("top %lu of %lu words\n", n, count);
+    for (unsigned long i = 0; i < n; i++) {
+        printf("%lu %s\n", top[i].count, top[i].word);
+    }
+    free(top);
+
+    unsigned long histogram[HISTOGRAM_BUCKETS] = { 0 };
+    interned_index_iterate(index, histogram_visit, histogram);
+
+    printf("\nfrequency histogram\n");
+    for (unsigned long b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        if (histogram[b] == 0) {
+            continue;
+        }
+        if (b == 0) {
+            printf("1 %lu\n", histogram[b]);
+        } else {
+            printf("%lu-%lu %lu\n", 1UL << b, (1UL << b << 1) - 1,
+                   histogram[b]);
+        }
+    }
+    return 0;
+}
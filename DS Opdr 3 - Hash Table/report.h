@@ -0,0 +1,33 @@
+/* Word frequency report interface
+ * The frequency of a word is the number of line numbers stored for it in
+ * the word index, so it is always up to date with the inserts. */
+
+#ifndef _REPORT_H_
+#define _REPORT_H_
+
+#include "word_index.h"
+
+/* Default number of words in the top-K report. */
+#define REPORT_TOP_K 10
+
+struct word_count {
+    const char *word;
+    unsigned long count;
+};
+
+/* Fills 'res' with the 'k' most frequent words of 'index', most frequent
+ * first and alphabetically for equal frequencies. Uses a heap of at most
+ * 'k' words, so the vocabulary is never sorted as a whole.
+ * Returns the number of words stored in 'res', which is less than 'k' if
+ * the index holds fewer words. */
+unsigned long top_k_words(const struct interned_index *index,
+                          struct word_count *res, unsigned long k);
+
+/* Prints the 'k' most frequent words of 'index' and a histogram of the
+ * number of words per frequency range (1, 2-3, 4-7, ...) to stdout. A 'k'
+ * larger than the number of words prints all words.
+ * Returns 0 if successful and 1 otherwise. */
+int print_frequency_report(const struct interned_index *index,
+                           unsigned long k);
+
+#endif
@@ -0,0 +1,322 @@
+/*
+Name: Boris Vukajlovic
+Ssid:15225054
+
+This program splits text files into words and builds word indices,
+mapping every word to the lines it occurs on, with the generic
+word_table or the interned index.*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "word_index.h"
+
+struct word_stream {
+    FILE *fp;
+    char *line;
+    char *delim;
+    long offset;
+    int line_number;
+};
+
+void cleanup_string(char *line) {
+    for (char *c = line; *c != '\0'; c++) {
+        *c = (char) tolower(*c);
+        if (!isalpha(*c)) {
+            *c = ' ';
+        }
+    }
+}
+
+char *calc_delim(void) {
+    const size_t ascii_table_size = 128;
+    char *res = malloc(sizeof(char) * ascii_table_size);
+    if (!res) {
+        return NULL;
+    }
+
+    int res_index = 0;
+    for (unsigned char c = 1; c < ascii_table_size; c++) {
+        if (!isalpha(c)) {   /* if it's not an alpha it's a delimiter char. */
+            res[res_index++] = (char) c;
+        }
+    }
+    res[res_index] = '\0';
+    return res;
+}
+
+/* Calls 'visit' with 'ctx' for every word in 'line', which is cleaned up
+ * in place. Returns 0 if succesful and 1 if 'visit' failed. */
+static int visit_line(char *line, const char *delim, int line_number,
+                      int (*visit)(void *ctx, char *word, int line_number),
+                      void *ctx) {
+    cleanup_string(line);
+    char *word = strtok(line, delim);
+
+    while (word != NULL) {
+        if (visit(ctx, word, line_number) != 0) {
+            return 1;
+        }
+        word = strtok(NULL, delim);
+    }
+    return 0;
+}
+
+int for_each_word(char *filename,
+                  int (*visit)(void *ctx, char *word, int line_number),
+                  void *ctx) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        return 1;
+    }
+
+    char *line = malloc(LINE_LENGTH * sizeof(char));
+    char *delim = calc_delim();
+    if (!line || !delim) {
+        free(line);
+        free(delim);
+        fclose(fp);
+        return 1;
+    }
+
+    int ret = 0;
+    int line_number = 0;
+    while (ret == 0 && fgets(line, LINE_LENGTH, fp)) {
+        line_number++;
+        ret = visit_line(line, delim, line_number, visit, ctx);
+    }
+
+    free(delim);
+    fclose(fp);
+    free(line);
+
+    return ret;
+}
+
+struct word_stream *word_stream_init(const char *filename) {
+    struct word_stream *s = malloc(sizeof(struct word_stream));
+    if (s == NULL) {
+        return NULL;
+    }
+
+    s->fp = fopen(filename, "r");
+    s->line = malloc(LINE_LENGTH * sizeof(char));
+    s->delim = calc_delim();
+    if (!s->fp || !s->line || !s->delim) {
+        if (s->fp) {
+            fclose(s->fp);
+        }
+        free(s->line);
+        free(s->delim);
+        free(s);
+        return NULL;
+    }
+
+    s->offset = 0;
+    s->line_number = 0;
+    return s;
+}
+
+long word_stream_update(struct word_stream *s,
+                        int (*visit)(void *ctx, char *word, int line_number),
+                        void *ctx) {
+    if (s == NULL) {
+        return -1;
+    }
+
+    /* A file that shrunk was rewritten, the index no longer matches it. */
+    if (fseek(s->fp, 0, SEEK_END) != 0 || ftell(s->fp) < s->offset) {
+        return -1;
+    }
+    if (fseek(s->fp, s->offset, SEEK_SET) != 0) {
+        return -1;
+    }
+
+    long new_lines = 0;
+    while (fgets(s->line, LINE_LENGTH, s->fp)) {
+        /* A line starting with a NUL byte has length 0. */
+        size_t len = strlen(s->line);
+        if ((len == 0 || s->line[len - 1] != '\n') && feof(s->fp)) {
+            break;
+        }
+
+        long offset = ftell(s->fp);
+        s->line_number++;
+        if (offset < 0 ||
+            visit_line(s->line, s->delim, s->line_number, visit, ctx) != 0) {
+            s->line_number--;
+            clearerr(s->fp);
+            return -1;
+        }
+        s->offset = offset;
+        new_lines++;
+    }
+
+    /* Clear the end of file flag so appended data is seen next time. */
+    clearerr(s->fp);
+    return new_lines;
+}
+
+long word_stream_offset(const struct word_stream *s) {
+    return s == NULL ? -1 : s->offset;
+}
+
+int word_stream_line(const struct word_stream *s) {
+    return s == NULL ? -1 : s->line_number;
+}
+
+void word_stream_cleanup(struct word_stream *s) {
+    if (s == NULL) {
+        return;
+    }
+    fclose(s->fp);
+    free(s->line);
+    free(s->delim);
+    free(s);
+}
+
+int word_table_add(void *ctx, char *word, int line_number) {
+    int inserted = 0;
+    struct array **lines = word_table_upsert(ctx, word, &inserted);
+    if (lines == NULL) {
+        return 1;
+    }
+
+    if (inserted) {
+        *lines = array_init(LINES_START_SIZE);
+        if (*lines == NULL) {
+            word_table_delete(ctx, word);
+            return 1;
+        }
+    }
+
+    return array_append(*lines, line_number);
+}
+
+struct interned_index *interned_index_init(struct intern_pool *pool,
+                                           unsigned long start_size) {
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    struct interned_index *index = malloc(sizeof(struct interned_index));
+    if (index == NULL) {
+        return NULL;
+    }
+
+    index->pool = pool;
+    index->capacity = start_size ? start_size : 1;
+    index->count = 0;
+    index->lines = calloc(index->capacity, sizeof(struct array *));
+    if (index->lines == NULL) {
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+/* Grows the line vector of 'index' so 'id' fits in it, at least doubling
+ * its capacity. Returns 0 if succesful and 1 otherwise. */
+static int interned_index_grow(struct interned_index *index,
+                               unsigned long id) {
+    unsigned long capacity = index->capacity * 2;
+    if (capacity <= id) {
+        capacity = id + 1;
+    }
+    if (capacity > SIZE_MAX / sizeof(struct array *)) {
+        return 1;
+    }
+
+    struct array **lines = realloc(index->lines,
+                                   capacity * sizeof(struct array *));
+    if (lines == NULL) {
+        return 1;
+    }
+    memset(lines + index->capacity, 0,
+           (capacity - index->capacity) * sizeof(struct array *));
+    index->lines = lines;
+    index->capacity = capacity;
+    return 0;
+}
+
+int interned_index_add(void *ctx, char *word, int line_number) {
+    struct interned_index *index = ctx;
+
+    unsigned long id = intern(index->pool, word);
+    if (id == INTERN_NONE) {
+        return 1;
+    }
+    if (id >= index->capacity && interned_index_grow(index, id) != 0) {
+        return 1;
+    }
+
+    if (index->lines[id] == NULL) {
+        index->lines[id] = array_init(LINES_START_SIZE);
+        if (index->lines[id] == NULL) {
+            return 1;
+        }
+        index->count++;
+    }
+
+    return array_append(index->lines[id], line_number);
+}
+
+struct array *interned_index_lookup(const struct interned_index *index,
+                                    const char *word) {
+    if (index == NULL || word == NULL) {
+        return NULL;
+    }
+
+    /* INTERN_NONE is never below the capacity. */
+    unsigned long id = intern_find(index->pool, word);
+    return id < index->capacity ? index->lines[id] : NULL;
+}
+
+unsigned long interned_index_count(const struct interned_index *index) {
+    return index == NULL ? 0 : index->count;
+}
+
+int interned_index_iterate(const struct interned_index *index,
+                           int (*visit)(void *ctx, unsigned long id,
+                                        struct array *lines),
+                           void *ctx) {
+    if (index == NULL || visit == NULL) {
+        return -1;
+    }
+    for (unsigned long id = 0; id < index->capacity; id++) {
+        if (index->lines[id] != NULL && visit(ctx, id, index->lines[id]) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void interned_index_cleanup(struct interned_index *index) {
+    if (index == NULL) {
+        return;
+    }
+    for (unsigned long id = 0; id < index->capacity; id++) {
+        word_lines_free(index->lines[id]);
+    }
+    free(index->lines);
+    free(index);
+}
+
+struct interned_index *create_interned_from_file(char *filename,
+                                                 struct intern_pool *pool,
+                                                 unsigned long start_size) {
+    struct interned_index *index = interned_index_init(pool, start_size);
+    if (index == NULL) {
+        return NULL;
+    }
+
+    if (for_each_word(filename, interned_index_add, index) != 0) {
+        interned_index_cleanup(index);
+        return NULL;
+    }
+
+    return index;
+}
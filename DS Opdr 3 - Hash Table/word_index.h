@@ -0,0 +1,129 @@
+/* Word index interface
+ * Splits text files into lowercase words and indexes the line numbers every
+ * word occurs on. */
+
+#ifndef _WORD_INDEX_H_
+#define _WORD_INDEX_H_
+
+#include "array.h"
+#include "hash_table_generic.h"
+#include "intern.h"
+
+/* Maximum length of a line that is read in one piece. */
+#define LINE_LENGTH 256
+
+/* Initial capacity of the line number array of a new word. */
+#define LINES_START_SIZE 10
+
+/* Frees the line number array of a word, which may still be NULL if the
+ * word was just inserted. */
+static inline void word_lines_free(struct array *lines) {
+    if (lines != NULL) {
+        array_cleanup(lines);
+    }
+}
+
+/* The word index: maps every word to the array of line numbers it is on,
+ * hashed with the (inlined) djb2 hash. */
+HASH_TABLE_DEFINE(word_table, char *, struct array *, ht_str_hash, ht_str_eq,
+                  ht_str_copy, ht_str_free, word_lines_free)
+
+/* A word index keyed on interned words. Interned ids are handed out
+ * consecutively from 0 (see intern.h), so the line arrays are stored in a
+ * vector indexed by id and a word costs one hash lookup in the pool. Ids of
+ * words that were only interned elsewhere have a NULL entry. The pool is not
+ * owned by the index, so the same pool can be shared with the queries and
+ * other structures. */
+struct interned_index {
+    struct intern_pool *pool;
+    struct array **lines;
+    unsigned long capacity;
+    unsigned long count;
+};
+
+/* Handle to a word stream, which remembers up to which byte offset and
+ * line number a growing file has been indexed. */
+struct word_stream;
+
+/* Replaces every non-alpha char in 'line' with a space and lowercases every
+ * char. */
+void cleanup_string(char *line);
+
+/* Returns a pointer to a heap allocated string with all the characters we
+ * use as word delimiters. Returns NULL on failure. */
+char *calc_delim(void);
+
+/* Calls 'visit' with 'ctx' for every word in the file 'filename' together
+ * with the number of the line it occurs on.
+ * Returns 0 if succesful and 1 if the file could not be read or 'visit'
+ * failed. */
+int for_each_word(char *filename,
+                  int (*visit)(void *ctx, char *word, int line_number),
+                  void *ctx);
+
+/* Opens 'filename' for incremental indexing, starting at its first byte.
+ * Returns a pointer to the stream or NULL on failure. */
+struct word_stream *word_stream_init(const char *filename);
+
+/* Calls 'visit' with 'ctx' for every word on the lines that were appended
+ * to the file since the previous call, numbering the lines on from where
+ * the previous call stopped. Only the new bytes are read. A last line
+ * without a newline may still be growing and is left for a later call.
+ * Returns the number of new lines, or -1 if the file was truncated, could
+ * not be read or 'visit' failed. */
+long word_stream_update(struct word_stream *s,
+                        int (*visit)(void *ctx, char *word, int line_number),
+                        void *ctx);
+
+/* Returns the byte offset up to which the file has been indexed. */
+long word_stream_offset(const struct word_stream *s);
+
+/* Returns the number of the last line that has been indexed. */
+int word_stream_line(const struct word_stream *s);
+
+/* Closes the file and cleans up the stream. */
+void word_stream_cleanup(struct word_stream *s);
+
+/* Appends 'line_number' to the line array of 'word' in the word index 'ctx'
+ * (a struct word_table). Returns 0 if succesful and 1 otherwise. */
+int word_table_add(void *ctx, char *word, int line_number);
+
+/* Initialise an interned index on 'pool' with room for the ids below
+ * 'start_size' before resizing. Returns a pointer to the index or NULL on
+ * failure. */
+struct interned_index *interned_index_init(struct intern_pool *pool,
+                                           unsigned long start_size);
+
+/* Interns 'word' and appends 'line_number' to its line array in the
+ * interned index 'ctx' (a struct interned_index).
+ * Returns 0 if succesful and 1 otherwise. */
+int interned_index_add(void *ctx, char *word, int line_number);
+
+/* Returns the line number array of 'word' in the interned index 'index',
+ * or NULL if the word is not present. */
+struct array *interned_index_lookup(const struct interned_index *index,
+                                    const char *word);
+
+/* Returns the number of words in the interned index 'index'. */
+unsigned long interned_index_count(const struct interned_index *index);
+
+/* Calls 'visit' with 'ctx' for every word in the interned index 'index' in
+ * order of id, until it returns non-zero.
+ * Returns 0 if every word was visited, 1 if 'visit' stopped early and -1 if
+ * an error occured. */
+int interned_index_iterate(const struct interned_index *index,
+                           int (*visit)(void *ctx, unsigned long id,
+                                        struct array *lines),
+                           void *ctx);
+
+/* Clean up the interned index, but not its intern pool. */
+void interned_index_cleanup(struct interned_index *index);
+
+/* Creates a word index keyed on words interned in 'pool' for the specified
+ * file, with room for 'start_size' words before resizing. Returns a pointer
+ * to the index or NULL if an error occured. */
+struct interned_index *create_interned_from_file(char *filename,
+                                                 struct intern_pool *pool,
+                                                 unsigned long start_size);
+
+#endif